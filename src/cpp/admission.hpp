@@ -0,0 +1,114 @@
+/*
+ * Project Aegis - Admission Control
+ * Priority lanes between parse and the worker rings.
+ *
+ * When a worker ring fills, ingress used to spin in a yield loop on push,
+ * stalling everything behind it — including the transfers regulators care
+ * about — while smaller messages held the queue. Admission control splits
+ * traffic into two lanes after parse:
+ *
+ *   HIGH — amount at or above a configurable micros threshold, or a
+ *          flagged currency. Keeps the blocking push: these must land.
+ *   LOW  — everything else. Admitted only while the ring has headroom
+ *          beyond a reserve kept free for the high lane; under overload
+ *          the surplus is shed immediately (counted, never spun on).
+ *
+ * Shedding small transfers deterministically bounds high-lane tail
+ * latency during volume spikes; per-lane admitted/shed counters are
+ * exported via metrics.hpp (aegis_lane_*_total).
+ */
+
+#ifndef ADMISSION_HPP
+#define ADMISSION_HPP
+
+#include "hft_core.hpp"
+#include "metrics.hpp"
+#include <string>
+#include <thread>
+#include <vector>
+
+enum class Lane { High = 0, Low = 1 };
+
+class AdmissionController {
+    PaymentRouter& payment_router;
+    int64_t high_amount_micros; // >= routes to the high lane
+    std::vector<std::string> flagged_ccys;
+
+    // Slots per ring kept free for the high lane. 1/8 of a 16K ring is
+    // 2K messages of guaranteed high-priority headroom per worker.
+    static constexpr size_t HIGH_RESERVE = PaymentRingBuffer::capacity() / 8;
+
+public:
+    // ccy_list: comma-separated currencies always routed high (may be empty).
+    AdmissionController(PaymentRouter& r, int64_t threshold_micros,
+                        const std::string& ccy_list = "")
+        : payment_router(r), high_amount_micros(threshold_micros) {
+        size_t pos = 0;
+        while (pos < ccy_list.size()) {
+            size_t end = ccy_list.find(',', pos);
+            if (end == std::string::npos) end = ccy_list.size();
+            if (end > pos) flagged_ccys.push_back(ccy_list.substr(pos, end - pos));
+            pos = end + 1;
+        }
+    }
+
+    PaymentRouter& router() { return payment_router; }
+
+    Lane classify(const PaymentData& pmt) const {
+        if (pmt.amount >= high_amount_micros) return Lane::High;
+        for (const std::string& ccy : flagged_ccys) {
+            if (strncmp(pmt.currency, ccy.c_str(), sizeof(pmt.currency)) == 0) {
+                return Lane::High;
+            }
+        }
+        return Lane::Low;
+    }
+
+    // Single-message path (replay driver). Returns false when shed.
+    bool submit(const PaymentData& pmt) {
+        size_t w = payment_router.worker_for(pmt);
+        if (classify(pmt) == Lane::High) {
+            submit_high(w, std::span<const PaymentData>(&pmt, 1));
+            return true;
+        }
+        return submit_low(w, std::span<const PaymentData>(&pmt, 1)) == 1;
+    }
+
+    // High lane: blocking, as ring-full stalls were for all traffic
+    // before — but now only messages that must land pay them.
+    void submit_high(size_t w, std::span<const PaymentData> items) {
+        std::span<const PaymentData> pending = items;
+        while (!pending.empty() && !force_quit) {
+            size_t pushed = payment_router.push_batch(w, pending);
+            pending = pending.subspan(pushed);
+            if (!pending.empty()) std::this_thread::yield();
+        }
+        Metrics::record_lane_admitted((int)Lane::High,
+                                      items.size() - pending.size());
+        if (!pending.empty()) {
+            // Only reachable on shutdown mid-burst.
+            Metrics::record_lane_shed((int)Lane::High, pending.size());
+        }
+    }
+
+    // Low lane: one attempt against the headroom beyond the high-lane
+    // reserve; the surplus is shed. No spinning, so overload converts to
+    // deterministic small-transfer loss instead of ingress stall.
+    size_t submit_low(size_t w, std::span<const PaymentData> items) {
+        size_t free_slots = payment_router.free_approx(w);
+        size_t budget = free_slots > HIGH_RESERVE ? free_slots - HIGH_RESERVE : 0;
+
+        size_t want = items.size() < budget ? items.size() : budget;
+        size_t pushed = 0;
+        if (want > 0) {
+            pushed = payment_router.push_batch(w, items.first(want));
+        }
+        if (pushed > 0) Metrics::record_lane_admitted((int)Lane::Low, pushed);
+        if (pushed < items.size()) {
+            Metrics::record_lane_shed((int)Lane::Low, items.size() - pushed);
+        }
+        return pushed;
+    }
+};
+
+#endif
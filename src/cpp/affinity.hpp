@@ -0,0 +1,152 @@
+/*
+ * Project Aegis - Thread Placement
+ * Explicit core assignment per engine role.
+ *
+ * Every engine thread (ingress pollers, risk workers, IPC sender, metrics
+ * server) registers its role here and gets pinned according to a startup
+ * topology spec:
+ *
+ *     --cpu-map "workers=4-7;ingress=2,3;ipc=1;metrics=0"
+ *
+ * Lists accept single cores and ranges, comma separated. A role with more
+ * threads than cores wraps modulo its list. Roles absent from the spec are
+ * left unpinned and float under the scheduler, matching the engine's
+ * behavior before --cpu-map existed. Placing the
+ * housekeeping roles (ipc, metrics) away from the worker cores isolates
+ * the hot path; on dual-socket hosts, keeping ingress and its workers on
+ * one node keeps ring traffic off the interconnect (ring pages are
+ * first-touched by their consumer — see main.cpp).
+ */
+
+#ifndef AFFINITY_HPP
+#define AFFINITY_HPP
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+enum class Role { Ingress = 0, Worker = 1, Ipc = 2, Metrics = 3 };
+
+class ThreadPlacement {
+public:
+    // Parses "role=list;role=list". Returns false (and logs) on a
+    // malformed spec; partial assignments before the error are kept.
+    static bool configure(const std::string& spec) {
+        size_t pos = 0;
+        while (pos < spec.size()) {
+            size_t end = spec.find(';', pos);
+            if (end == std::string::npos) end = spec.size();
+            std::string entry = spec.substr(pos, end - pos);
+            pos = end + 1;
+            if (entry.empty()) continue;
+
+            size_t eq = entry.find('=');
+            if (eq == std::string::npos) {
+                printf("[AFFINITY] Bad cpu-map entry (missing '='): %s\n", entry.c_str());
+                return false;
+            }
+            std::string role_name = entry.substr(0, eq);
+            int role = role_index(role_name);
+            if (role < 0) {
+                printf("[AFFINITY] Unknown role in cpu-map: %s\n", role_name.c_str());
+                return false;
+            }
+            if (!parse_core_list(entry.substr(eq + 1), cores()[role])) {
+                printf("[AFFINITY] Bad core list for %s: %s\n",
+                       role_name.c_str(), entry.substr(eq + 1).c_str());
+                return false;
+            }
+        }
+        configured() = true;
+        return true;
+    }
+
+    // Pins the calling thread per the topology. Safe to call when no
+    // topology is configured: unconfigured roles float, exactly as they
+    // did before --cpu-map existed.
+    static void pin_current(Role role, size_t index) {
+#ifndef _WIN32
+        const std::vector<int>& list = cores()[(int)role];
+        if (list.empty()) return;
+        int core = list[index % list.size()];
+
+        cpu_set_t cpuset;
+        CPU_ZERO(&cpuset);
+        CPU_SET(core, &cpuset);
+        if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset) == 0) {
+            printf("[AFFINITY] %s[%zu] pinned to core %d\n", name(role), index, core);
+        } else {
+            printf("[AFFINITY] %s[%zu] pin to core %d failed\n", name(role), index, core);
+        }
+#else
+        (void)role; (void)index;
+#endif
+    }
+
+    static const char* name(Role role) {
+        switch (role) {
+            case Role::Ingress: return "ingress";
+            case Role::Worker:  return "worker";
+            case Role::Ipc:     return "ipc";
+            case Role::Metrics: return "metrics";
+        }
+        return "?";
+    }
+
+private:
+    static std::vector<int>* cores() {
+        static std::vector<int> lists[4];
+        return lists;
+    }
+    static bool& configured() {
+        static bool c = false;
+        return c;
+    }
+
+    static int role_index(const std::string& s) {
+        if (s == "ingress") return (int)Role::Ingress;
+        if (s == "workers" || s == "worker") return (int)Role::Worker;
+        if (s == "ipc") return (int)Role::Ipc;
+        if (s == "metrics") return (int)Role::Metrics;
+        return -1;
+    }
+
+    // "0,2,4-7" -> {0,2,4,5,6,7}
+    static bool parse_core_list(const std::string& s, std::vector<int>& out) {
+        out.clear();
+        size_t pos = 0;
+        while (pos < s.size()) {
+            size_t end = s.find(',', pos);
+            if (end == std::string::npos) end = s.size();
+            std::string tok = s.substr(pos, end - pos);
+            pos = end + 1;
+            if (tok.empty()) return false;
+
+            size_t dash = tok.find('-');
+            char* parse_end = nullptr;
+            if (dash == std::string::npos) {
+                long core = strtol(tok.c_str(), &parse_end, 10);
+                if (*parse_end != '\0' || core < 0) return false;
+                out.push_back((int)core);
+            } else {
+                // Named locals keep the substrings alive across the
+                // *parse_end check (a temporary dies at the semicolon).
+                std::string lo_tok = tok.substr(0, dash);
+                std::string hi_tok = tok.substr(dash + 1);
+                long lo = strtol(lo_tok.c_str(), &parse_end, 10);
+                if (*parse_end != '\0' || lo < 0) return false;
+                long hi = strtol(hi_tok.c_str(), &parse_end, 10);
+                if (*parse_end != '\0' || hi < lo) return false;
+                for (long c = lo; c <= hi; ++c) out.push_back((int)c);
+            }
+        }
+        return !out.empty();
+    }
+};
+
+#endif
@@ -0,0 +1,214 @@
+/*
+ * Project Aegis - Binary Capture Journal
+ * Fixed-size PaymentData records; append-only, background-fsync'd.
+ *
+ * Replaying a text capture re-pays the XML parse for every message. The
+ * journal instead logs the already-parsed PaymentData structs as raw
+ * fixed-size records behind a small header, so yesterday's session can be
+ * replayed I/O-bound with zero parsing (see FileIngress in main.cpp). The
+ * writer is fed by the ingress path through an MPMC ring and never blocks
+ * it: a full queue drops the journal record (counted), not the payment.
+ * Because records are flushed and fsync'd on a short interval, the journal
+ * doubles as a crash-recovery log of everything ingress accepted.
+ *
+ * The header pins sizeof(PaymentData); appending to or replaying a capture
+ * taken under a different struct layout is rejected rather than mis-read.
+ */
+
+#ifndef CAPTURE_HPP
+#define CAPTURE_HPP
+
+#include "hft_core.hpp"
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// =============================================================================
+// 1. On-Disk Format
+// =============================================================================
+
+struct CaptureHeader {
+    char     magic[4];     // "AEGC"
+    uint16_t version;      // bumped on any format change
+    uint16_t record_size;  // sizeof(PaymentData) at capture time
+    uint64_t reserved;     // future: capture flags / session id
+};
+static_assert(sizeof(CaptureHeader) == 16, "Capture header must stay 16 bytes");
+static_assert(std::is_trivially_copyable_v<PaymentData>,
+              "Journal records are raw memcpy'd PaymentData");
+
+constexpr char     CAPTURE_MAGIC[4] = {'A', 'E', 'G', 'C'};
+constexpr uint16_t CAPTURE_VERSION  = 1;
+
+// True when a mapped/loaded buffer starts with a valid capture header for
+// the current PaymentData layout. Used by FileIngress to auto-detect
+// binary captures vs. newline-delimited XML.
+inline bool is_capture_buffer(const void* base, size_t size) {
+    if (size < sizeof(CaptureHeader)) return false;
+    CaptureHeader hdr;
+    memcpy(&hdr, base, sizeof(hdr));
+    return memcmp(hdr.magic, CAPTURE_MAGIC, 4) == 0 &&
+           hdr.version == CAPTURE_VERSION &&
+           hdr.record_size == sizeof(PaymentData);
+}
+
+// =============================================================================
+// 2. Capture Writer
+// =============================================================================
+
+class CaptureWriter {
+    // Fan-in from all ingress threads (replay driver or Kafka pollers).
+    MpmcRingBuffer<PaymentData, 8192> queue;
+    std::thread writer_thread;
+    std::atomic<bool> running{false};
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<uint64_t> written{0};
+    int fd = -1;
+
+    // Flush cadence: bounded data-loss window on crash without an fsync
+    // per record.
+    static constexpr int    FSYNC_INTERVAL_MS = 250;
+    static constexpr size_t DRAIN_BATCH = 256;
+
+public:
+    ~CaptureWriter() { stop(); }
+
+    // Opens (or appends to) the journal and starts the background writer.
+    // Appending to a capture from a different PaymentData layout fails.
+    bool start(const std::string& path) {
+#ifdef _WIN32
+        printf("[CAPTURE] Journaling not supported on this platform.\n");
+        (void)path;
+        return false;
+#else
+        fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+        if (fd < 0) {
+            printf("[CAPTURE] Cannot open %s for append.\n", path.c_str());
+            return false;
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            ::close(fd); fd = -1;
+            return false;
+        }
+        if (st.st_size == 0) {
+            CaptureHeader hdr{};
+            memcpy(hdr.magic, CAPTURE_MAGIC, 4);
+            hdr.version = CAPTURE_VERSION;
+            hdr.record_size = (uint16_t)sizeof(PaymentData);
+            if (::write(fd, &hdr, sizeof(hdr)) != (ssize_t)sizeof(hdr)) {
+                printf("[CAPTURE] Header write failed.\n");
+                ::close(fd); fd = -1;
+                return false;
+            }
+        } else {
+            // Validate the existing header via a read-only reopen; the
+            // append fd never seeks.
+            int rfd = ::open(path.c_str(), O_RDONLY);
+            CaptureHeader hdr{};
+            bool ok = rfd >= 0 &&
+                      ::read(rfd, &hdr, sizeof(hdr)) == (ssize_t)sizeof(hdr) &&
+                      is_capture_buffer(&hdr, sizeof(hdr));
+            if (rfd >= 0) ::close(rfd);
+            if (!ok) {
+                printf("[CAPTURE] %s is not a v%u capture for this build; refusing to append.\n",
+                       path.c_str(), (unsigned)CAPTURE_VERSION);
+                ::close(fd); fd = -1;
+                return false;
+            }
+        }
+
+        running = true;
+        writer_thread = std::thread(&CaptureWriter::writer_loop, this);
+        printf("[CAPTURE] Journaling to %s (%zu-byte records).\n",
+               path.c_str(), sizeof(PaymentData));
+        return true;
+#endif
+    }
+
+    // Hot-path hook: non-blocking. A full writer queue sacrifices the
+    // journal record, never ingress throughput.
+    void record(const PaymentData& pmt) {
+        if (!running.load(std::memory_order_relaxed)) return;
+        if (!queue.push(pmt)) dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Idempotent, and deliberately NOT gated on `running`: the writer
+    // thread clears the flag itself on a journal write failure (e.g. disk
+    // full), and skipping the join in that case would hand ~CaptureWriter
+    // a joinable thread — std::terminate at shutdown.
+    void stop() {
+        running.store(false);
+        if (writer_thread.joinable()) writer_thread.join();
+#ifndef _WIN32
+        if (fd >= 0) {
+            fsync(fd);
+            ::close(fd);
+            fd = -1;
+            printf("[CAPTURE] Journal closed. %llu records written, %llu dropped.\n",
+                   (unsigned long long)written.load(),
+                   (unsigned long long)dropped.load());
+        }
+#endif
+    }
+
+    uint64_t records_written() const { return written.load(std::memory_order_relaxed); }
+    uint64_t records_dropped() const { return dropped.load(std::memory_order_relaxed); }
+
+private:
+#ifndef _WIN32
+    void writer_loop() {
+        PaymentData batch[DRAIN_BATCH];
+        auto last_sync = std::chrono::steady_clock::now();
+        bool dirty = false;
+
+        // Drain until stop() AND the queue is empty, so shutdown flushes
+        // everything ingress managed to enqueue.
+        for (;;) {
+            size_t n = 0;
+            while (n < DRAIN_BATCH && queue.pop(batch[n])) ++n;
+
+            if (n > 0) {
+                const char* p = (const char*)batch;
+                size_t remaining = n * sizeof(PaymentData);
+                while (remaining > 0) {
+                    ssize_t w = ::write(fd, p, remaining);
+                    if (w <= 0) {
+                        printf("[CAPTURE] Journal write failed; stopping.\n");
+                        running = false;
+                        return;
+                    }
+                    p += w;
+                    remaining -= (size_t)w;
+                }
+                written.fetch_add(n, std::memory_order_relaxed);
+                dirty = true;
+            } else if (!running.load(std::memory_order_acquire)) {
+                break;
+            } else {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+
+            auto now = std::chrono::steady_clock::now();
+            if (dirty && now - last_sync >=
+                    std::chrono::milliseconds(FSYNC_INTERVAL_MS)) {
+                fsync(fd);
+                last_sync = now;
+                dirty = false;
+            }
+        }
+        if (dirty) fsync(fd);
+    }
+#endif
+};
+
+#endif
@@ -0,0 +1,250 @@
+/*
+ * Project Aegis - Risk-State Checkpoint
+ * Periodic shard snapshots to a binary file; restore on startup.
+ *
+ * FastRiskEngine state was purely in-memory: a restart lost every
+ * EntityState velocity and structuring history, so for minutes after a
+ * deploy repeat offenders scored as first-time entities. The checkpointer
+ * walks the 1024 shards on a background thread: each shard's live slots
+ * are copied out under its existing mutex (a bounded memcpy sweep — the
+ * lock is never held for I/O), serialized as fixed-size records, and the
+ * whole snapshot is fsync'd and atomically renamed over the previous one.
+ * Restore runs before the pre-warm phase (see main.cpp), re-seating every
+ * entity with the same seeding semantics as a tiered re-fetch, so the
+ * engine resumes with yesterday's detection state already on the
+ * lock-free hit path.
+ *
+ * The header pins the record layout; restoring a snapshot taken under a
+ * different layout is rejected rather than mis-read.
+ */
+
+#ifndef CHECKPOINT_HPP
+#define CHECKPOINT_HPP
+
+#include "risk_engine.hpp"
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// =============================================================================
+// 1. On-Disk Format
+// =============================================================================
+
+struct CheckpointHeader {
+    char     magic[4];     // "AEGS"
+    uint16_t version;      // bumped on any format change
+    uint16_t record_size;  // sizeof(CheckpointRecord) at snapshot time
+    uint64_t reserved;     // future: snapshot flags / engine epoch
+};
+static_assert(sizeof(CheckpointHeader) == 16, "Checkpoint header must stay 16 bytes");
+
+// One entity's durable detection state. The bucket-level window history
+// is deliberately not persisted (same policy as the spill path): the
+// rolling sum is re-seated into the current bucket on restore and decays
+// out over the window.
+struct CheckpointRecord {
+    char     key[FlatEntityMap::KEY_CAP];
+    uint64_t last_seen;
+    float    velocity;
+    float    structuring;
+};
+static_assert(std::is_trivially_copyable_v<CheckpointRecord>,
+              "Checkpoint records are raw memcpy'd");
+
+constexpr char     CHECKPOINT_MAGIC[4] = {'A', 'E', 'G', 'S'};
+constexpr uint16_t CHECKPOINT_VERSION  = 1;
+
+// =============================================================================
+// 2. Checkpointer
+// =============================================================================
+
+class RiskCheckpoint {
+    FastRiskEngine& engine;
+    std::thread snapshot_thread;
+    std::atomic<bool> running{false};
+    std::atomic<uint64_t> snapshots_taken{0};
+    std::string path;
+    uint64_t interval_ms = 30000;
+
+public:
+    explicit RiskCheckpoint(FastRiskEngine& eng) : engine(eng) {}
+    ~RiskCheckpoint() { stop(); }
+
+    // Loads a snapshot into the engine. Call before ingress (and before
+    // the pre-warm phase, which then touches the restored pages). A
+    // missing file is a clean first boot, not an error; a file with the
+    // wrong layout is refused.
+    bool restore(const std::string& snapshot_path) {
+#ifdef _WIN32
+        printf("[CHECKPOINT] Not supported on this platform.\n");
+        (void)snapshot_path;
+        return false;
+#else
+        int fd = ::open(snapshot_path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            printf("[CHECKPOINT] No snapshot at %s; starting cold.\n",
+                   snapshot_path.c_str());
+            return false;
+        }
+
+        CheckpointHeader hdr{};
+        if (::read(fd, &hdr, sizeof(hdr)) != (ssize_t)sizeof(hdr) ||
+            memcmp(hdr.magic, CHECKPOINT_MAGIC, 4) != 0 ||
+            hdr.version != CHECKPOINT_VERSION ||
+            hdr.record_size != sizeof(CheckpointRecord)) {
+            printf("[CHECKPOINT] %s is not a v%u snapshot for this build; ignoring.\n",
+                   snapshot_path.c_str(), (unsigned)CHECKPOINT_VERSION);
+            ::close(fd);
+            return false;
+        }
+
+        CheckpointRecord rec;
+        uint64_t restored = 0;
+        while (::read(fd, &rec, sizeof(rec)) == (ssize_t)sizeof(rec)) {
+            rec.key[sizeof(rec.key) - 1] = '\0';
+            engine.restore_entity(rec.key, strlen(rec.key),
+                                  rec.last_seen, rec.velocity, rec.structuring);
+            restored++;
+        }
+        ::close(fd);
+        printf("[CHECKPOINT] Restored %llu entities from %s.\n",
+               (unsigned long long)restored, snapshot_path.c_str());
+        return true;
+#endif
+    }
+
+    // Starts the periodic background snapshotter.
+    void start(const std::string& snapshot_path, uint64_t snapshot_interval_ms) {
+#ifdef _WIN32
+        (void)snapshot_path; (void)snapshot_interval_ms;
+#else
+        if (running.exchange(true)) return;
+        path = snapshot_path;
+        interval_ms = snapshot_interval_ms;
+        snapshot_thread = std::thread(&RiskCheckpoint::snapshot_loop, this);
+        printf("[CHECKPOINT] Snapshotting to %s every %llu ms.\n",
+               path.c_str(), (unsigned long long)interval_ms);
+#endif
+    }
+
+    void stop() {
+        if (!running.exchange(false)) return;
+        if (snapshot_thread.joinable()) snapshot_thread.join();
+#ifndef _WIN32
+        // Final snapshot so a clean shutdown loses nothing since the last
+        // interval tick.
+        write_snapshot(path);
+#endif
+        printf("[CHECKPOINT] Stopped after %llu snapshots.\n",
+               (unsigned long long)snapshots_taken.load());
+    }
+
+    uint64_t snapshots() const { return snapshots_taken.load(std::memory_order_relaxed); }
+
+    // Writes one full snapshot: shard-at-a-time copy under each shard's
+    // mutex, serialization and I/O between lock releases, then fsync and
+    // an atomic rename over the previous snapshot (readers always see a
+    // complete file or the old one, never a torn write).
+    bool write_snapshot(const std::string& to) {
+#ifdef _WIN32
+        (void)to;
+        return false;
+#else
+        const std::string tmp = to + ".tmp";
+        int fd = ::open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) {
+            printf("[CHECKPOINT] Cannot open %s for write.\n", tmp.c_str());
+            return false;
+        }
+
+        CheckpointHeader hdr{};
+        memcpy(hdr.magic, CHECKPOINT_MAGIC, 4);
+        hdr.version = CHECKPOINT_VERSION;
+        hdr.record_size = (uint16_t)sizeof(CheckpointRecord);
+        if (!write_all(fd, &hdr, sizeof(hdr))) {
+            ::close(fd);
+            return false;
+        }
+
+        // Per-shard scratch: bounded by the shard occupancy cap.
+        std::vector<FlatEntityMap::Evicted> live(FlatEntityMap::MAX_OCCUPANCY);
+        std::vector<CheckpointRecord> out(FlatEntityMap::MAX_OCCUPANCY);
+        uint64_t total = 0;
+
+        for (FastRiskEngine::RiskShard& shard : engine.shards) {
+            size_t n;
+            {
+                std::lock_guard<std::mutex> lock(shard.mtx);
+                n = shard.map.export_live(live.data(), live.size());
+            }
+            for (size_t i = 0; i < n; ++i) {
+                memcpy(out[i].key, live[i].key, sizeof(out[i].key));
+                out[i].last_seen = live[i].last_seen;
+                out[i].velocity = live[i].velocity;
+                out[i].structuring = live[i].structuring;
+            }
+            if (n > 0 && !write_all(fd, out.data(), n * sizeof(CheckpointRecord))) {
+                ::close(fd);
+                ::unlink(tmp.c_str());
+                return false;
+            }
+            total += n;
+        }
+
+        fsync(fd);
+        ::close(fd);
+        if (::rename(tmp.c_str(), to.c_str()) != 0) {
+            printf("[CHECKPOINT] Rename to %s failed.\n", to.c_str());
+            ::unlink(tmp.c_str());
+            return false;
+        }
+        snapshots_taken.fetch_add(1, std::memory_order_relaxed);
+        printf("[CHECKPOINT] Snapshot #%llu: %llu entities.\n",
+               (unsigned long long)snapshots_taken.load(),
+               (unsigned long long)total);
+        return true;
+#endif
+    }
+
+private:
+#ifndef _WIN32
+    void snapshot_loop() {
+        while (running.load(std::memory_order_relaxed)) {
+            // Sliced sleep so stop() is honored within ~100ms.
+            for (uint64_t slept = 0;
+                 slept < interval_ms && running.load(std::memory_order_relaxed);
+                 slept += 100) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            }
+            if (!running.load(std::memory_order_relaxed)) break;
+            write_snapshot(path);
+        }
+    }
+
+    static bool write_all(int fd, const void* buf, size_t len) {
+        const char* p = (const char*)buf;
+        while (len > 0) {
+            ssize_t w = ::write(fd, p, len);
+            if (w <= 0) {
+                printf("[CHECKPOINT] Snapshot write failed.\n");
+                return false;
+            }
+            p += w;
+            len -= (size_t)w;
+        }
+        return true;
+    }
+#endif
+};
+
+#endif
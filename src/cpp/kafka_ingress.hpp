@@ -5,118 +5,235 @@
  * PRODUCTION UPDATE:
  * 1. Removed Hardcoded "Mock XML".
  * 2. Implements real polling structure for RdKafka.
+ * 3. Parallel ingress: N pollers in one consumer group, so the broker
+ *    spreads the topic's partitions across them (24-partition topics no
+ *    longer bottleneck on a single polling/parsing thread).
  */
 
 #ifndef KAFKA_INGRESS_HPP
 #define KAFKA_INGRESS_HPP
 
 #include "hft_core.hpp"
+#include "metrics.hpp"
+#include "affinity.hpp"
+#include "capture.hpp"
+#include "admission.hpp"
 #include <thread>
+#include <atomic>
 #include <iostream>
 #include <vector>
 #include <string>
 #include <librdkafka/rdkafkacpp.h>
 
 class KafkaIngress {
-    PaymentRingBuffer& ring_buffer;
-    std::thread consumer_thread;
-    bool running = false;
-    RdKafka::KafkaConsumer* consumer = nullptr;
+    using ParseFn = bool (*)(const char*, size_t, PaymentData&);
+
+    AdmissionController& admission;
+    PaymentRouter& router;
+    CaptureWriter* capture; // optional binary journal; may be null
+    ParseFn parse_fn = &IsoParser::parse; // generic probe unless bound (set_schema())
+    std::vector<std::thread> consumer_threads;
+    std::vector<RdKafka::KafkaConsumer*> consumers;
+    std::atomic<bool> running{false};
 
 public:
-    KafkaIngress(PaymentRingBuffer& rb) : ring_buffer(rb) {}
+    KafkaIngress(AdmissionController& adm, CaptureWriter* cap = nullptr)
+        : admission(adm), router(adm.router()), capture(cap) {}
 
     ~KafkaIngress() {
         stop();
-        if (consumer) {
-            consumer->close();
-            delete consumer;
+        for (RdKafka::KafkaConsumer* c : consumers) {
+            c->close();
+            delete c;
         }
         RdKafka::wait_destroyed(5000);
     }
 
-    void start(const std::string& brokers, const std::string& topic) {
-        std::string errstr;
-
-        // 1. Configuration
-        RdKafka::Conf* conf = RdKafka::Conf::create(RdKafka::Conf::CONF_GLOBAL);
-        if (conf->set("bootstrap.servers", brokers, errstr) != RdKafka::Conf::CONF_OK) {
-             std::cerr << "[KAFKA] Config Error: " << errstr << std::endl;
-             delete conf;
-             return;
+    // Binds the topic's declared schema to a compile-time specialized
+    // parser instantiation. The binding is explicit operator configuration
+    // (--topic-schema): a topic's name says nothing reliable about its
+    // payload, so nothing is inferred from it — without a binding the
+    // generic probing parser stays in place and accepts every supported
+    // envelope and currency, exactly as before specialization existed.
+    // Returns false (and leaves the parser unchanged) for unknown names.
+    // The pugixml conformance build has no specializations; it only
+    // accepts "generic".
+    bool set_schema(const std::string& schema) {
+        if (schema == "generic") {
+            parse_fn = &IsoParser::parse;
+            return true;
         }
-        conf->set("group.id", "aegis_group_v1", errstr);
-        conf->set("enable.auto.commit", "false", errstr);
-        conf->set("auto.offset.reset", "latest", errstr);
-
-        // 2. Create Consumer
-        consumer = RdKafka::KafkaConsumer::create(conf, errstr);
-        if (!consumer) {
-            std::cerr << "[KAFKA] Creation Failed: " << errstr << std::endl;
+#ifndef AEGIS_USE_PUGIXML_PARSER
+        if (schema == "pain001")     { parse_fn = &BasicIsoParser<Pain001Policy>::parse;    return true; }
+        if (schema == "pacs008")     { parse_fn = &BasicIsoParser<Pacs008Policy>::parse;    return true; }
+        if (schema == "pain001-eur") { parse_fn = &BasicIsoParser<Pain001EurPolicy>::parse; return true; }
+        if (schema == "pacs008-eur") { parse_fn = &BasicIsoParser<Pacs008EurPolicy>::parse; return true; }
+#endif
+        return false;
+    }
+
+    // Spawns num_consumers pollers that all join the same consumer group;
+    // Kafka's group rebalancing assigns each a disjoint partition set and
+    // each commits offsets only for its own assignment. Size num_consumers
+    // toward the topic's partition count (or a divisor of it).
+    void start(const std::string& brokers, const std::string& topic, size_t num_consumers = 1) {
+        if (num_consumers < 1) num_consumers = 1;
+
+        for (size_t i = 0; i < num_consumers; ++i) {
+            std::string errstr;
+
+            // 1. Configuration (one Conf per consumer; rdkafka consumes it)
+            RdKafka::Conf* conf = RdKafka::Conf::create(RdKafka::Conf::CONF_GLOBAL);
+            if (conf->set("bootstrap.servers", brokers, errstr) != RdKafka::Conf::CONF_OK) {
+                 std::cerr << "[KAFKA] Config Error: " << errstr << std::endl;
+                 delete conf;
+                 return;
+            }
+            conf->set("group.id", "aegis_group_v1", errstr);
+            conf->set("enable.auto.commit", "false", errstr);
+            conf->set("auto.offset.reset", "latest", errstr);
+
+            // 2. Create Consumer
+            RdKafka::KafkaConsumer* consumer = RdKafka::KafkaConsumer::create(conf, errstr);
+            if (!consumer) {
+                std::cerr << "[KAFKA] Creation Failed: " << errstr << std::endl;
+                delete conf;
+                return;
+            }
             delete conf;
-            return;
-        }
-        delete conf;
-
-        // 3. Subscribe
-        std::vector<std::string> topics;
-        topics.push_back(topic);
-        RdKafka::ErrorCode err = consumer->subscribe(topics);
-        if (err) {
-            std::cerr << "[KAFKA] Subscribe Failed: " << RdKafka::err2str(err) << std::endl;
-            return;
+
+            // 3. Subscribe (group membership drives partition assignment)
+            std::vector<std::string> topics;
+            topics.push_back(topic);
+            RdKafka::ErrorCode err = consumer->subscribe(topics);
+            if (err) {
+                std::cerr << "[KAFKA] Subscribe Failed: " << RdKafka::err2str(err) << std::endl;
+                consumer->close();
+                delete consumer;
+                return;
+            }
+
+            consumers.push_back(consumer);
         }
 
-        running = true;
-        consumer_thread = std::thread(&KafkaIngress::consumer_loop, this);
-        std::cout << "[KAFKA] Connected to " << brokers << " | Topic: " << topic << std::endl;
+        running.store(true);
+        for (size_t i = 0; i < consumers.size(); ++i) {
+            consumer_threads.emplace_back(&KafkaIngress::consumer_loop, this, consumers[i], i);
+        }
+        std::cout << "[KAFKA] Connected to " << brokers << " | Topic: " << topic
+                  << " | Pollers: " << consumers.size() << std::endl;
     }
 
     void stop() {
-        running = false;
-        if (consumer_thread.joinable()) consumer_thread.join();
+        running.store(false);
+        for (std::thread& t : consumer_threads) {
+            if (t.joinable()) t.join();
+        }
+        consumer_threads.clear();
     }
 
 private:
-    void consumer_loop() {
-        if (!consumer) return;
+    // One blocking poll, then non-blocking drains until the batch fills or
+    // the local queue is empty. Amortizes per-poll overhead over the batch.
+    static constexpr size_t POLL_BATCH = 256;
 
-        PaymentData pmt;
-        int msg_count = 0;
-
-        while (running && !force_quit) {
-            // 2. Poll (Real Blocking Call)
-            RdKafka::Message* msg = consumer->consume(100); // 100ms
-
-            switch (msg->err()) {
-                case RdKafka::ERR_NO_ERROR: {
-                    // 3. Parse Real Data
-                    std::string payload(static_cast<const char*>(msg->payload()), msg->len());
-                    // Assuming IsoParser is available from hft_core.hpp or similar context
-                    if (IsoParser::parse(payload.c_str(), payload.length(), pmt)) {
-                         while (!ring_buffer.push(pmt) && running) {
-                             // Backpressure
-                             std::this_thread::yield();
-                         }
-
-                         msg_count++;
-                         // Batched Commit (Every 1000 messages)
-                         if (msg_count % 1000 == 0) {
-                             consumer->commitAsync(NULL);
-                         }
-                    }
+    void consumer_loop(RdKafka::KafkaConsumer* consumer, size_t poller_id) {
+        if (!consumer) return;
+        ThreadPlacement::pin_current(Role::Ingress, poller_id);
+
+        std::vector<RdKafka::Message*> msgs;
+        msgs.reserve(POLL_BATCH);
+
+        // Parsed messages staged per destination worker and priority lane
+        // for batch push through admission control.
+        std::vector<std::vector<PaymentData>> staging_high(router.worker_count());
+        std::vector<std::vector<PaymentData>> staging_low(router.worker_count());
+        for (auto& group : staging_high) group.reserve(POLL_BATCH);
+        for (auto& group : staging_low) group.reserve(POLL_BATCH);
+
+        size_t msg_count = 0;
+
+        while (running.load(std::memory_order_relaxed) && !force_quit) {
+            // 1. Batched Poll (stage time includes broker wait, so the
+            // poll row in /debug/stats separates idle from work).
+            uint64_t t_poll = Metrics::now_ticks();
+            msgs.push_back(consumer->consume(100)); // blocking head of batch
+            while (msgs.size() < POLL_BATCH) {
+                RdKafka::Message* m = consumer->consume(0);
+                if (m->err() == RdKafka::ERR__TIMED_OUT) {
+                    delete m;
                     break;
                 }
-                case RdKafka::ERR__TIMED_OUT:
-                case RdKafka::ERR__PARTITION_EOF:
-                    break;
-                default:
-                    // Log error (msg->errstr())
-                    break;
+                msgs.push_back(m);
+            }
+            Metrics::record_stage_cycles(Metrics::STAGE_KAFKA_POLL,
+                                         Metrics::now_ticks() - t_poll,
+                                         msgs.size());
+
+            // 2. Parse directly from the librdkafka payload (no std::string copy).
+            for (RdKafka::Message* msg : msgs) {
+                switch (msg->err()) {
+                    case RdKafka::ERR_NO_ERROR: {
+                        PaymentData pmt;
+                        const char* payload = static_cast<const char*>(msg->payload());
+                        uint64_t t0 = Metrics::now_ticks();
+                        if (parse_fn(payload, msg->len(), pmt)) {
+                            uint64_t t1 = Metrics::now_ticks();
+                            Metrics::record_parse_latency(t1 - t0);
+                            Metrics::record_stage_cycles(Metrics::STAGE_PARSE, t1 - t0);
+                            pmt.ingress_ticks = t1; // enqueue timestamp
+                            if (capture) capture->record(pmt);
+                            size_t w = router.worker_for(pmt);
+                            if (admission.classify(pmt) == Lane::High) {
+                                staging_high[w].push_back(pmt);
+                            } else {
+                                staging_low[w].push_back(pmt);
+                            }
+                            msg_count++;
+                        }
+                        break;
+                    }
+                    case RdKafka::ERR__TIMED_OUT:
+                    case RdKafka::ERR__PARTITION_EOF:
+                        break;
+                    default:
+                        // Log error (msg->errstr())
+                        break;
+                }
+                delete msg;
+            }
+            msgs.clear();
+
+            // 3. Batch push per worker ring through admission control:
+            // high lane lands (blocking), low lane sheds under overload.
+            uint64_t t_push = Metrics::now_ticks();
+            uint64_t pushed = 0;
+            for (size_t w = 0; w < staging_high.size(); ++w) {
+                if (!staging_high[w].empty()) {
+                    pushed += staging_high[w].size();
+                    admission.submit_high(w, std::span<const PaymentData>(staging_high[w]));
+                    staging_high[w].clear();
+                }
+                if (!staging_low[w].empty()) {
+                    pushed += staging_low[w].size();
+                    admission.submit_low(w, std::span<const PaymentData>(staging_low[w]));
+                    staging_low[w].clear();
+                }
+            }
+            if (pushed > 0) {
+                Metrics::record_stage_cycles(Metrics::STAGE_RING_PUSH,
+                                             Metrics::now_ticks() - t_push, pushed);
+            }
+
+            // Batched Commit (Every ~1000 messages; covers only this
+            // poller's assigned partitions)
+            if (msg_count >= 1000) {
+                consumer->commitAsync(NULL);
+                msg_count = 0;
             }
-            delete msg;
         }
     }
+
 };
 
 #endif
@@ -15,6 +15,11 @@
 #include "telemetry.hpp"
 #include "rules_loader.hpp"
 #include "metrics.hpp"
+#include "affinity.hpp"
+#include "capture.hpp"
+#include "checkpoint.hpp"
+#include "admission.hpp"
+#include "tcp_sink.hpp"
 #include <fstream>
 #include <iostream>
 #include <thread>
@@ -23,22 +28,66 @@
 
 #include <zmq.hpp>
 
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// --- WORKER POOL CONFIG ---
+// One SPSC ring per worker; ingress partitions by debtor-name hash so the
+// producer side of each ring is single-threaded (ingress) and the consumer
+// is the owning worker.
+constexpr size_t MAX_WORKERS = 8;
+constexpr size_t DEFAULT_WORKERS = 4;
+
+// Consumer idle behavior (--wait-mode spin|adaptive|yield).
+// Dedicated-core hosts run pure busy-spin; shared hosts use the adaptive tier.
+static WaitMode g_wait_mode = WaitMode::SpinPause;
+
+// IPC batch flush deadline (--ipc-flush-us): a partial batch is held at
+// most this long before it goes out.
+static uint64_t g_ipc_flush_us = 200;
+
 // Global Instances
 static FastRiskEngine g_risk_engine;
-static PaymentRingBuffer g_ring_buffer; // 16K slots
+// 16K slots each; arena-backed so ring hot loops run on huge pages too.
+// Storage is reserved in main() but each ring is constructed by its own
+// worker thread after pinning, so first-touch places the pages on the
+// consumer's NUMA node (no libnuma dependency needed).
+static PaymentRingBuffer* g_worker_rings = nullptr;
+static std::atomic<size_t> g_rings_ready{0};
 
 // TELEMETRY/IPC
-struct IpcMessage {
-    char data[512];
-    size_t len;
-};
-
-using IpcRingBuffer = LockFreeRingBuffer<IpcMessage, 4096>;
+// MPMC: every risk worker pushes alerts concurrently, lock-free.
+using IpcRingBuffer = MpmcRingBuffer<IpcMessage, 4096>;
 static IpcRingBuffer g_ipc_buffer;
 
+// Binary ingress journal (--capture <path>). Inert until started; record()
+// is a no-op when journaling is off.
+static CaptureWriter g_capture;
+
+// Compliance-team TCP alert feed (--tcp-sink host:port). Mirrors every
+// flushed alert; inert until started.
+static TcpAlertSink g_tcp_sink;
+
+// Detection-state checkpointer (--checkpoint <path>). Restores on startup
+// and snapshots periodically; inert until started.
+static RiskCheckpoint g_checkpoint(g_risk_engine);
+
 // --- IPC SENDER THREAD ---
+// Batching sender: alerts drain into a staging batch that is flushed as
+// ONE multipart message on batch-full or when the oldest staged alert
+// hits the flush deadline (--ipc-flush-us). Each part is still a complete
+// JSON alert, so the Python bridge's recv_string()-per-alert loop is
+// unchanged, but the wire and syscall cost is paid once per batch instead
+// of once per alert, and delivery latency is bounded by the deadline
+// rather than an idle-loop sleep.
 void ipc_sender_worker() {
-    printf("[IPC] ZeroMQ Sender Thread Started.\n");
+    ThreadPlacement::pin_current(Role::Ipc, 0);
+    printf("[IPC] ZeroMQ Sender Thread Started (batch<=%zu, flush %lluus).\n",
+           (size_t)64, (unsigned long long)g_ipc_flush_us);
 
     zmq::context_t ctx;
     zmq::socket_t sock(ctx, zmq::socket_type::push);
@@ -51,38 +100,126 @@ void ipc_sender_worker() {
         return;
     }
 
-    while (!force_quit) {
-        IpcMessage msg;
-        // Drain buffer
-        while (g_ipc_buffer.pop(msg)) {
-            try {
-                // Zero-Copy send using buffer view
-                sock.send(zmq::buffer(msg.data, msg.len), zmq::send_flags::dontwait);
-            } catch (const zmq::error_t& e) {
-                // Silently drop or log if needed
+    constexpr size_t IPC_BATCH_MAX = 64;
+    std::array<IpcMessage, IPC_BATCH_MAX> batch;
+    size_t staged = 0;
+    uint64_t oldest_ticks = 0; // enqueue time of batch[0]
+    const uint64_t deadline_ns = g_ipc_flush_us * 1000;
+
+    auto flush = [&]() {
+        uint64_t t_send = Metrics::now_ticks();
+        for (size_t i = 0; i < staged; ++i) g_tcp_sink.send(batch[i]);
+
+        // With dontwait, backpressure comes back as an empty send_result_t
+        // (EAGAIN), not an exception. ZMQ applies the high-water mark when
+        // the FIRST part of a message is queued, so the batch is probed
+        // there: a refusal drops the whole batch, counted. Once a sndmore
+        // part is in, the remaining parts are sent blocking — they must
+        // follow to close the multipart message rather than leak into the
+        // next flush, and ZMQ admits frames of an already-started message
+        // without re-checking the HWM, so in practice they never block.
+        size_t accepted = 0;
+        try {
+            auto first = sock.send(
+                zmq::buffer(batch[0].data, batch[0].len),
+                staged == 1 ? zmq::send_flags::dontwait
+                            : (zmq::send_flags::dontwait | zmq::send_flags::sndmore));
+            if (first) {
+                accepted = 1;
+                for (size_t i = 1; i < staged; ++i) {
+                    sock.send(zmq::buffer(batch[i].data, batch[i].len),
+                              (i == staged - 1) ? zmq::send_flags::none
+                                                : zmq::send_flags::sndmore);
+                    accepted++;
+                }
             }
+        } catch (const zmq::error_t&) {
+            // Hard socket error (e.g. ETERM during shutdown): anything not
+            // yet accepted is lost with the socket.
         }
+        if (accepted < staged) Metrics::record_drop(staged - accepted);
 
-        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        uint64_t t_sent = Metrics::now_ticks();
+        Metrics::record_stage_cycles(Metrics::STAGE_ZMQ_SEND, t_sent - t_send, staged);
+        Metrics::record_ipc_flush_latency(t_sent - oldest_ticks);
+        staged = 0;
+    };
+
+    WaitStrategy waiter(g_wait_mode);
+    while (!force_quit) {
+        bool drained_any = false;
+        while (staged < IPC_BATCH_MAX && g_ipc_buffer.pop(batch[staged])) {
+            if (staged == 0) oldest_ticks = Metrics::now_ticks();
+            staged++;
+            drained_any = true;
+        }
+
+        if (staged == IPC_BATCH_MAX) {
+            flush();
+        } else if (staged > 0 &&
+                   Metrics::ticks_to_ns(Metrics::now_ticks() - oldest_ticks) >= deadline_ns) {
+            flush();
+        }
+
+        Metrics::set_ipc_queue_depth(g_ipc_buffer.size_approx() + staged);
+
+        if (drained_any) {
+            waiter.reset();
+        } else {
+            waiter.idle();
+        }
     }
+    if (staged > 0) flush();
     sock.close();
     ctx.close();
 }
 
 // --- WORKER ---
-void risk_worker() {
-    printf("[WORKER] Risk Engine On-Line. Core Affine.\n");
-    PaymentData item;
+void risk_worker(size_t worker_id) {
+    // Pin first so the ring construction below first-touches its pages on
+    // this worker's core (and NUMA node).
+    ThreadPlacement::pin_current(Role::Worker, worker_id);
+    PaymentRingBuffer* ring = new (&g_worker_rings[worker_id]) PaymentRingBuffer();
+    // Fault in the slot pages now (NUMA-local, no producer attached yet)
+    // so the first real burst never stalls on demand paging.
+    ring->prefault();
+    g_rings_ready.fetch_add(1, std::memory_order_release);
+    printf("[WORKER %zu] Risk Engine On-Line. Core Affine.\n", worker_id);
+
+    // Batch drain: one tail update per batch instead of per message.
+    constexpr size_t DRAIN_BATCH = 64;
+    std::array<PaymentData, DRAIN_BATCH> batch;
+    WaitStrategy waiter(g_wait_mode);
 
     while (!force_quit) {
         // Wait-Free Consumer
-        while (g_ring_buffer.pop(item)) {
+        size_t count;
+        uint64_t t_pop = Metrics::now_ticks();
+        while ((count = ring->pop_batch(std::span<PaymentData>(batch))) > 0) {
+          waiter.reset();
+          uint64_t t_dequeue = Metrics::now_ticks();
+          Metrics::record_stage_cycles(Metrics::STAGE_RING_POP,
+                                       t_dequeue - t_pop, count);
+          // Occupancy AFTER the drain plus what we just took: the depth
+          // the ring reached before this batch. Feeds the high-water mark.
+          Metrics::record_ring_occupancy(worker_id,
+                                         count + ring->size_approx(),
+                                         PaymentRingBuffer::capacity());
+          for (size_t i = 0; i < count; ++i) {
+            const PaymentData& item = batch[i];
+
             // METRICS: Record transaction
             Metrics::record_transaction();
+            Metrics::record_ring_wait(t_dequeue - item.ingress_ticks);
 
             auto span = Telemetry::start_span("risk_check");
 
+            uint64_t t_eval = Metrics::now_ticks();
             FastRiskEngine::RiskResult risk = g_risk_engine.evaluate(item.debtor_name, strlen(item.debtor_name), item.amount);
+            uint64_t t_done = Metrics::now_ticks();
+            Metrics::record_evaluate_latency(t_done - t_eval);
+            Metrics::record_stage_cycles(Metrics::STAGE_EVALUATE, t_done - t_eval);
+            Metrics::record_e2e_latency(t_done - item.ingress_ticks);
 
             Telemetry::end_span(span, risk.score, risk.is_blocked);
 
@@ -96,55 +233,252 @@ void risk_worker() {
              // ASYNC PUSH (Non-Blocking)
              if (risk.score > 0.5) {
                  IpcMessage msg;
-                 int len = snprintf(msg.data, 512,
-                     // Integer-based string formatting (Micros -> Decimal String)
-                     "{ \"debtor\": \"%s\", \"amount\": %lld.%06lld, \"uetr\": \"%s\" }",
-                     item.debtor_name, (long long)(item.amount / 1000000), (long long)(std::abs(item.amount % 1000000)), item.uetr
-                  );
-                 if (len > 0 && len < 512) {
-                     msg.len = len;
-                     if (!g_ipc_buffer.push(msg)) {
-                         // METRICS: Record drop due to backpressure
-                         Metrics::record_drop();
-                     }
+                 // Fixed-layout serializer: no snprintf on the hot path.
+                 uint64_t t_fmt = Metrics::now_ticks();
+                 AlertSerializer::serialize(item, msg);
+                 Metrics::record_stage_cycles(Metrics::STAGE_ALERT_FORMAT,
+                                              Metrics::now_ticks() - t_fmt);
+                 if (!g_ipc_buffer.push(msg)) {
+                     // METRICS: Record drop due to backpressure
+                     Metrics::record_drop();
                  }
              }
+          }
+          t_pop = Metrics::now_ticks();
         }
 
         // METRICS: Update ring buffer usage and TPS periodically
         Metrics::calculate_tps();
 
-        std::this_thread::yield();
+        waiter.idle();
     }
 }
 
 // --- FILE INGRESS (REPLAY MODE) ---
+// Load-test driver. Memory-maps the capture and scans line boundaries with
+// memchr, parsing each message in place: no per-line std::string, no
+// buffered read syscalls, and the kernel prefetches sequentially
+// (MADV_SEQUENTIAL). Supports a paced mode (--replay-rate msgs/sec) and an
+// as-fast-as-possible mode (rate 0); both report achieved TPS and
+// parse-latency percentiles on completion so replay doubles as the
+// load-test rig.
+//
+// Binary captures (see capture.hpp) are auto-detected by header magic and
+// replayed record-by-record with zero parsing, so re-running a journaled
+// session is I/O-bound rather than parser-bound.
 class FileIngress {
-    PaymentRingBuffer& ring_buffer;
+    AdmissionController& admission;
+    PaymentRouter& router;
+    uint64_t target_rate; // messages/sec; 0 = as fast as possible
+
+    // Pacing granularity: re-sync against the wall clock every slice.
+    static constexpr uint64_t PACE_SLICE = 1024;
+
 public:
-    FileIngress(PaymentRingBuffer& rb) : ring_buffer(rb) {}
+    FileIngress(AdmissionController& adm, uint64_t rate = 0)
+        : admission(adm), router(adm.router()), target_rate(rate) {}
 
     void run(const std::string& filepath) {
-        printf("[REPLAY] Reading logs from %s...\n", filepath.c_str());
-        std::ifstream infile(filepath, std::ios::binary);
-        if (!infile) {
+        ThreadPlacement::pin_current(Role::Ingress, 0);
+#ifdef _WIN32
+        printf("[REPLAY] Error: mmap replay is not supported on this platform.\n");
+        (void)filepath;
+#else
+        int fd = ::open(filepath.c_str(), O_RDONLY);
+        if (fd < 0) {
             printf("[REPLAY] Error: File not found.\n");
             return;
         }
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size == 0) {
+            printf("[REPLAY] Error: Empty or unreadable file.\n");
+            ::close(fd);
+            return;
+        }
+        const size_t size = (size_t)st.st_size;
+        void* base = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (base == MAP_FAILED) {
+            printf("[REPLAY] Error: mmap failed.\n");
+            return;
+        }
+        madvise(base, size, MADV_SEQUENTIAL);
 
-        std::string line;
-        while (std::getline(infile, line) && !force_quit) {
-            PaymentData pmt;
-            if (IsoParser::parse(line.c_str(), line.length(), pmt)) {
-                 while (!ring_buffer.push(pmt) && !force_quit) {
-                     std::this_thread::yield();
-                 }
+        printf("[REPLAY] Mapped %s (%.1f MB) | Rate: ", filepath.c_str(), (double)size / 1048576.0);
+        if (target_rate) printf("%llu msg/s\n", (unsigned long long)target_rate);
+        else             printf("unthrottled\n");
+
+        if (is_capture_buffer(base, size)) {
+            run_binary(base, size);
+            munmap(base, size);
+            return;
+        }
+
+        Metrics::LatencyHistogram parse_hist;
+        uint64_t sent = 0, failed = 0, shed = 0;
+        auto t_start = std::chrono::steady_clock::now();
+
+        const char* cur = (const char*)base;
+        const char* end = cur + size;
+        while (cur < end && !force_quit) {
+            const char* nl = (const char*)memchr(cur, '\n', (size_t)(end - cur));
+            const size_t len = nl ? (size_t)(nl - cur) : (size_t)(end - cur);
+            if (len > 0) {
+                PaymentData pmt;
+                uint64_t t0 = Metrics::now_ticks();
+                if (IsoParser::parse(cur, len, pmt)) {
+                    uint64_t t1 = Metrics::now_ticks();
+                    Metrics::record_parse_latency(t1 - t0);
+                    Metrics::record_stage_cycles(Metrics::STAGE_PARSE, t1 - t0);
+                    parse_hist.record_ticks(t1 - t0);
+                    pmt.ingress_ticks = t1;
+                    g_capture.record(pmt);
+                    if (admission.submit(pmt)) sent++;
+                    else                       shed++;
+                    Metrics::record_stage_cycles(Metrics::STAGE_RING_PUSH,
+                                                 Metrics::now_ticks() - t1);
+
+                    // Paced mode: sleep off any lead over the target
+                    // schedule, re-synced once per slice.
+                    if (target_rate && (sent % PACE_SLICE == 0)) {
+                        auto expected = t_start + std::chrono::nanoseconds(
+                            sent * 1000000000ULL / target_rate);
+                        std::this_thread::sleep_until(expected);
+                    }
+                } else {
+                    failed++;
+                }
             }
+            if (!nl) break;
+            cur = nl + 1;
         }
-        printf("[REPLAY] Finished.\n");
+
+        double secs = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - t_start).count();
+        munmap(base, size);
+
+        printf("[REPLAY] Finished. %llu msgs (%llu unparseable, %llu shed) in %.2fs | %.0f msg/s\n",
+               (unsigned long long)sent, (unsigned long long)failed,
+               (unsigned long long)shed, secs,
+               secs > 0 ? (double)sent / secs : 0.0);
+        printf("[REPLAY] Parse latency: p50 <= %lluns | p90 <= %lluns | p99 <= %lluns\n",
+               (unsigned long long)parse_hist.percentile_ns(0.50),
+               (unsigned long long)parse_hist.percentile_ns(0.90),
+               (unsigned long long)parse_hist.percentile_ns(0.99));
+#endif
+    }
+
+#ifndef _WIN32
+private:
+    // Zero-parse path: records are raw PaymentData structs, memcpy'd off
+    // the mapping and routed. Trailing partial records (torn final write
+    // after a crash) are skipped with a note.
+    void run_binary(const void* base, size_t size) {
+        const char* cur = (const char*)base + sizeof(CaptureHeader);
+        const size_t body = size - sizeof(CaptureHeader);
+        const uint64_t total = body / sizeof(PaymentData);
+        const size_t torn = body % sizeof(PaymentData);
+        if (torn) {
+            printf("[REPLAY] Capture has %zu trailing bytes (torn record); ignored.\n", torn);
+        }
+        printf("[REPLAY] Binary capture: %llu records, zero-parse.\n",
+               (unsigned long long)total);
+
+        uint64_t sent = 0, shed = 0;
+        auto t_start = std::chrono::steady_clock::now();
+
+        PaymentData pmt;
+        for (uint64_t i = 0; i < total && !force_quit; ++i) {
+            memcpy(&pmt, cur + i * sizeof(PaymentData), sizeof(PaymentData));
+            pmt.ingress_ticks = Metrics::now_ticks(); // re-stamp for this run
+            if (admission.submit(pmt)) sent++;
+            else                       shed++;
+            Metrics::record_stage_cycles(Metrics::STAGE_RING_PUSH,
+                                         Metrics::now_ticks() - pmt.ingress_ticks);
+
+            if (target_rate && (sent % PACE_SLICE == 0)) {
+                auto expected = t_start + std::chrono::nanoseconds(
+                    sent * 1000000000ULL / target_rate);
+                std::this_thread::sleep_until(expected);
+            }
+        }
+
+        double secs = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - t_start).count();
+        printf("[REPLAY] Finished. %llu records (%llu shed) in %.2fs | %.0f msg/s (binary)\n",
+               (unsigned long long)sent, (unsigned long long)shed, secs,
+               secs > 0 ? (double)sent / secs : 0.0);
     }
+#endif
 };
 
+// --- STARTUP PRE-WARM ---
+// The first minutes after a deploy used to be the worst latency window:
+// ring and shard pages faulted in lazily and the first real burst hit the
+// parse/evaluate path with cold icache and untrained branch predictors,
+// which confined deploys to low-volume windows. This phase runs after the
+// workers are up and strictly before ingress subscribes: it touches every
+// shard's slot pages, optionally seeds yesterday's hot entities
+// (--prewarm-entities <file>, one debtor name per line) so they take the
+// lock-free hit path immediately, and drives a few thousand synthetic
+// pain.001 messages through parse + evaluate. The flat shard maps never
+// rehash (fixed capacity at construction), so there is no growth to
+// pre-empt — the win is paging, cache and predictor state. Worker rings
+// prefault their own pages NUMA-locally (see risk_worker).
+static void prewarm_engine(const std::string& entities_file) {
+    uint64_t t0 = Metrics::now_ticks();
+
+    // 1. Shard slot pages.
+    g_risk_engine.prewarm_touch();
+
+    // 2. Yesterday's hot entities.
+    size_t seeded = 0;
+    if (!entities_file.empty()) {
+        std::ifstream in(entities_file);
+        if (!in) {
+            printf("[PREWARM] Cannot read %s; skipping entity seed.\n",
+                   entities_file.c_str());
+        }
+        std::string name;
+        while (std::getline(in, name)) {
+            if (name.empty()) continue;
+            g_risk_engine.prewarm_entity(name.c_str(), name.size());
+            seeded++;
+        }
+    }
+
+    // 3. Synthetic traffic through parse + evaluate, on this thread: no
+    // ring or IPC involvement, so nothing synthetic reaches the workers,
+    // the metrics or the bridge. 256 throwaway names spread the touches
+    // across shards; their velocity decays out of the rolling window
+    // within seconds.
+    constexpr size_t WARM_MSGS = 4096;
+    constexpr size_t WARM_NAMES = 256;
+    char msg[512];
+    PaymentData pmt;
+    size_t parsed = 0;
+    for (size_t i = 0; i < WARM_MSGS; ++i) {
+        int len = snprintf(msg, sizeof(msg),
+            "<?xml version=\"1.0\"?>"
+            "<Document xmlns=\"urn:iso:std:iso:20022:tech:xsd:pain.001.001.03\">"
+            "<CstmrCdtTrfinitn><PmtInf>"
+            "<Dbtr><Nm>prewarm-entity-%03zu</Nm></Dbtr>"
+            "<Cdtr><Nm>Prewarm Counterparty</Nm></Cdtr>"
+            "<Amt><InstdAmt Ccy=\"EUR\">%zu.50</InstdAmt></Amt>"
+            "<PmtId><UETR>550e8400-e29b-41d4-a716-446655440000</UETR></PmtId>"
+            "</PmtInf></CstmrCdtTrfinitn></Document>",
+            i % WARM_NAMES, 100 + (i % 900));
+        if (IsoParser::parse(msg, (size_t)len, pmt)) {
+            g_risk_engine.evaluate(pmt.debtor_name, strlen(pmt.debtor_name), pmt.amount);
+            parsed++;
+        }
+    }
+
+    double ms = (double)Metrics::ticks_to_ns(Metrics::now_ticks() - t0) / 1e6;
+    printf("[PREWARM] Shards touched | %zu hot entities seeded | %zu/%zu synthetic msgs | %.1f ms.\n",
+           seeded, parsed, WARM_MSGS, ms);
+}
+
 int main(int argc, char *argv[]) {
     std::cout << "============================================" << std::endl;
     std::cout << "   PROJECT AEGIS - HFT COMPLIANCE ENGINE    " << std::endl;
@@ -152,12 +486,91 @@ int main(int argc, char *argv[]) {
 
     bool replay_mode = false;
     std::string replay_file;
+    std::string capture_file;
+    std::string tcp_sink_peer; // host:port
+    uint64_t replay_rate = 0; // 0 = unthrottled
+    size_t num_workers = DEFAULT_WORKERS;
+    size_t ingress_threads = 1;
+    // High lane default: 10,000.00 units and up (micros).
+    int64_t high_lane_micros = 10000LL * 1000000LL;
+    std::string high_lane_ccys;
+    bool prewarm = true;
+    std::string prewarm_entities_file;
+    std::string checkpoint_file;
+    uint64_t checkpoint_interval_s = 30;
+    // Explicit topic->parser binding (--topic-schema); empty keeps the
+    // generic probing parser, which accepts every supported envelope.
+    std::string topic_schema;
 
     for (int i=1; i<argc; i++) {
         if (std::string(argv[i]) == "--replay-mode" && i+1 < argc) {
             replay_mode = true;
             replay_file = argv[i+1];
         }
+        if (std::string(argv[i]) == "--cpu-map" && i+1 < argc) {
+            if (!ThreadPlacement::configure(argv[i+1])) {
+                printf("[ENGINE] Invalid --cpu-map spec.\n");
+                return 1;
+            }
+        }
+        if (std::string(argv[i]) == "--replay-rate" && i+1 < argc) {
+            replay_rate = std::stoull(argv[i+1]);
+        }
+        if (std::string(argv[i]) == "--capture" && i+1 < argc) {
+            capture_file = argv[i+1];
+        }
+        if (std::string(argv[i]) == "--high-lane-micros" && i+1 < argc) {
+            high_lane_micros = std::stoll(argv[i+1]);
+        }
+        if (std::string(argv[i]) == "--high-lane-ccy" && i+1 < argc) {
+            high_lane_ccys = argv[i+1];
+        }
+        if (std::string(argv[i]) == "--tcp-sink" && i+1 < argc) {
+            tcp_sink_peer = argv[i+1];
+        }
+        if (std::string(argv[i]) == "--topic-schema" && i+1 < argc) {
+            topic_schema = argv[i+1];
+        }
+        if (std::string(argv[i]) == "--checkpoint" && i+1 < argc) {
+            checkpoint_file = argv[i+1];
+        }
+        if (std::string(argv[i]) == "--checkpoint-interval-s" && i+1 < argc) {
+            checkpoint_interval_s = std::stoull(argv[i+1]);
+        }
+        if (std::string(argv[i]) == "--no-prewarm") {
+            prewarm = false;
+        }
+        if (std::string(argv[i]) == "--prewarm-entities" && i+1 < argc) {
+            prewarm_entities_file = argv[i+1];
+        }
+        if (std::string(argv[i]) == "--ipc-flush-us" && i+1 < argc) {
+            g_ipc_flush_us = std::stoull(argv[i+1]);
+            if (g_ipc_flush_us < 1) g_ipc_flush_us = 1;
+        }
+        if (std::string(argv[i]) == "--wait-mode" && i+1 < argc) {
+            std::string mode = argv[i+1];
+            if (mode == "spin")     g_wait_mode = WaitMode::BusySpin;
+            if (mode == "adaptive") g_wait_mode = WaitMode::SpinPause;
+            if (mode == "yield")    g_wait_mode = WaitMode::Yielding;
+        }
+        if (std::string(argv[i]) == "--ingress-threads" && i+1 < argc) {
+            ingress_threads = std::stoul(argv[i+1]);
+            if (ingress_threads < 1) ingress_threads = 1;
+        }
+        if (std::string(argv[i]) == "--workers" && i+1 < argc) {
+            num_workers = std::stoul(argv[i+1]);
+            if (num_workers < 1) num_workers = 1;
+            if (num_workers > MAX_WORKERS) num_workers = MAX_WORKERS;
+        }
+    }
+
+    // 0. Memory layout (huge-page arena backs shard maps + worker rings)
+    {
+        HugePageArena& arena = HugePageArena::global();
+        printf("[ARENA] Backing: %s | Used: %.1f MB / %.1f MB\n",
+               arena.backing_name(),
+               (double)arena.used() / 1048576.0,
+               (double)arena.capacity() / 1048576.0);
     }
 
     // 1. Setup Telemetry
@@ -165,32 +578,103 @@ int main(int argc, char *argv[]) {
 
     // 1b. Setup Prometheus Metrics Server (port 9090)
     Metrics::init(9090);
+    // /debug/stats shard section reads the engine's per-shard counts.
+    Metrics::set_shard_stats_provider(+[](std::ostringstream& out) {
+        g_risk_engine.export_shard_stats_json(out);
+    });
+
+    // Eviction safety needs the ingress partition modulus before anything
+    // inserts into the shards (see FlatEntityMap::find_or_insert_evicting).
+    g_risk_engine.set_worker_partitions(num_workers);
 
     // 2. Rules Loader
     RulesLoader rules_loader(g_risk_engine);
-    rules_loader.start("model_weights.json");
+    rules_loader.start("config/model_weights.json");
+
+    // 2b. Tiered Storage (async spill of evicted entities)
+    g_risk_engine.start_tiering();
+
+    // 2c. Detection-state checkpoint: restore yesterday's entity state
+    // before anything touches the shards (the pre-warm phase then finds
+    // the restored pages already populated), then snapshot periodically.
+    if (!checkpoint_file.empty()) {
+        g_checkpoint.restore(checkpoint_file);
+        g_checkpoint.start(checkpoint_file, checkpoint_interval_s * 1000);
+    }
 
     // 3a. Start IPC Thread (ZMQ)
     std::thread ipc_thread(ipc_sender_worker);
     ipc_thread.detach();
 
-    // 3b. Start Worker
-    std::thread worker(risk_worker);
-    worker.detach();
+    // 3b. Start Worker Pool (per-core SPSC rings)
+    // Reserve ring storage without touching it; each worker constructs its
+    // own ring after pinning so the pages land NUMA-local to the consumer.
+    void* ring_mem = HugePageArena::global().allocate(
+        sizeof(PaymentRingBuffer) * MAX_WORKERS, alignof(PaymentRingBuffer));
+    if (!ring_mem) {
+        ring_mem = ::operator new(sizeof(PaymentRingBuffer) * MAX_WORKERS,
+                                  std::align_val_t(alignof(PaymentRingBuffer)));
+    }
+    g_worker_rings = static_cast<PaymentRingBuffer*>(ring_mem);
+
+    printf("[ENGINE] Spawning %zu risk workers.\n", num_workers);
+    for (size_t w = 0; w < num_workers; ++w) {
+        std::thread worker(risk_worker, w);
+        worker.detach();
+    }
+    // Ingress must not route into unconstructed rings.
+    while (g_rings_ready.load(std::memory_order_acquire) < num_workers) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    PaymentRouter router(g_worker_rings, num_workers);
+    AdmissionController admission(router, high_lane_micros, high_lane_ccys);
+
+    // 3b2. Pre-warm pages, hot entities and code paths before ingress
+    // subscribes (--no-prewarm to skip, e.g. in tests).
+    if (prewarm) {
+        prewarm_engine(prewarm_entities_file);
+    }
+
+    // 3c. Optional binary ingress journal
+    if (!capture_file.empty() && !g_capture.start(capture_file)) {
+        printf("[ENGINE] Capture journal unavailable; continuing without.\n");
+    }
+
+    // 3d. Optional TCP compliance feed
+    if (!tcp_sink_peer.empty()) {
+        size_t colon = tcp_sink_peer.find(':');
+        if (colon == std::string::npos) {
+            printf("[ENGINE] Bad --tcp-sink spec (expected host:port).\n");
+            return 1;
+        }
+        g_tcp_sink.start(tcp_sink_peer.substr(0, colon),
+                         std::stoi(tcp_sink_peer.substr(colon + 1)));
+    }
 
     if (replay_mode) {
-        FileIngress ingress(g_ring_buffer);
+        FileIngress ingress(admission, replay_rate);
         ingress.run(replay_file);
         std::this_thread::sleep_for(std::chrono::seconds(2));
     } else {
-        KafkaIngress ingress(g_ring_buffer);
-        ingress.start("kafka-broker:9092", "transactions.euro.v1");
+        KafkaIngress ingress(admission, capture_file.empty() ? nullptr : &g_capture);
+        if (!topic_schema.empty() && !ingress.set_schema(topic_schema)) {
+            printf("[ENGINE] Unknown --topic-schema '%s' (expected generic, "
+                   "pain001, pacs008, pain001-eur or pacs008-eur).\n",
+                   topic_schema.c_str());
+            return 1;
+        }
+        ingress.start("kafka-broker:9092", "transactions.euro.v1", ingress_threads);
         std::this_thread::sleep_for(std::chrono::seconds(5));
         ingress.stop();
     }
 
     force_quit = true;
+    g_capture.stop();
+    g_checkpoint.stop(); // takes a final snapshot
+    g_tcp_sink.stop();
     rules_loader.stop();
+    g_risk_engine.stop_tiering();
+    Telemetry::shutdown();
     Metrics::shutdown();
     printf("[ENGINE] Shutdown.\n");
     return 0;
@@ -10,6 +10,13 @@
  * - aegis_ring_buffer_usage: Ring buffer utilization (0.0 - 1.0)
  * - aegis_transactions_total: Total transactions processed (Counter)
  * - aegis_risk_blocks_total: Total transactions blocked (Counter)
+ * - aegis_*_latency_seconds: Per-stage latency histograms (parse,
+ *   evaluate, ring residency, end-to-end), power-of-two buckets
+ *
+ * A second endpoint, /debug/stats, serves engineering-grade introspection
+ * as JSON: raw per-stage cycle counters, ring occupancy high-water marks,
+ * shard-lock wait accumulation and per-shard entry counts. See
+ * export_debug_json().
  */
 
 #ifndef METRICS_HPP
@@ -21,8 +28,14 @@
 #include <string>
 #include <sstream>
 #include <thread>
+#include "affinity.hpp"
 #include <mutex>
 #include <cstdio>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+    #include <immintrin.h>
+#endif
 
 #ifdef _WIN32
     #include <winsock2.h>
@@ -46,9 +59,18 @@ static std::atomic<uint64_t> g_transactions_total{0};
 static std::atomic<uint64_t> g_risk_blocks_total{0};
 static std::atomic<uint64_t> g_drops_total{0};
 
+// Admission lanes (index 0 = high priority, 1 = low; see admission.hpp)
+static std::atomic<uint64_t> g_lane_admitted_total[2] = {};
+static std::atomic<uint64_t> g_lane_shed_total[2] = {};
+
+// TCP alert sink (see tcp_sink.hpp)
+static std::atomic<uint64_t> g_tcp_sink_drops_total{0};
+static std::atomic<uint64_t> g_tcp_sink_reconnects_total{0};
+
 // Gauges (point-in-time values)
 static std::atomic<double> g_ring_buffer_usage{0.0};
 static std::atomic<double> g_ingress_tps{0.0};
+static std::atomic<uint64_t> g_ipc_queue_depth{0};
 
 // Internal: for TPS calculation
 static std::atomic<uint64_t> g_tx_count_window{0};
@@ -67,8 +89,28 @@ inline void record_block() {
     g_risk_blocks_total.fetch_add(1, std::memory_order_relaxed);
 }
 
-inline void record_drop() {
-    g_drops_total.fetch_add(1, std::memory_order_relaxed);
+inline void record_drop(uint64_t n = 1) {
+    g_drops_total.fetch_add(n, std::memory_order_relaxed);
+}
+
+inline void record_lane_admitted(int lane, uint64_t n = 1) {
+    g_lane_admitted_total[lane].fetch_add(n, std::memory_order_relaxed);
+}
+
+inline void record_lane_shed(int lane, uint64_t n = 1) {
+    g_lane_shed_total[lane].fetch_add(n, std::memory_order_relaxed);
+}
+
+inline void record_tcp_sink_drop() {
+    g_tcp_sink_drops_total.fetch_add(1, std::memory_order_relaxed);
+}
+
+inline void record_tcp_sink_reconnect() {
+    g_tcp_sink_reconnects_total.fetch_add(1, std::memory_order_relaxed);
+}
+
+inline void set_ipc_queue_depth(size_t depth) {
+    g_ipc_queue_depth.store(depth, std::memory_order_relaxed);
 }
 
 inline void update_ring_buffer_usage(size_t current_size, size_t max_size) {
@@ -76,6 +118,191 @@ inline void update_ring_buffer_usage(size_t current_size, size_t max_size) {
     g_ring_buffer_usage.store(usage, std::memory_order_relaxed);
 }
 
+// =============================================================================
+// Latency Histograms (HDR-style, power-of-two buckets)
+// =============================================================================
+
+// Cheap hot-path timestamps: raw TSC ticks on x86-64 (calibrated to ns at
+// init, no serialization), steady_clock elsewhere.
+inline uint64_t now_ticks() {
+#if defined(__x86_64__) || defined(_M_X64)
+    return __rdtsc();
+#else
+    return (uint64_t)std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+}
+
+static std::atomic<double> g_ns_per_tick{1.0};
+
+inline uint64_t ticks_to_ns(uint64_t ticks) {
+    return (uint64_t)((double)ticks * g_ns_per_tick.load(std::memory_order_relaxed));
+}
+
+// Measures TSC frequency against steady_clock. Called once from init();
+// blocks ~50ms, long before the hot path starts.
+inline void calibrate_tsc() {
+#if defined(__x86_64__) || defined(_M_X64)
+    auto t0 = std::chrono::steady_clock::now();
+    uint64_t c0 = now_ticks();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    auto t1 = std::chrono::steady_clock::now();
+    uint64_t c1 = now_ticks();
+
+    double elapsed_ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+    if (c1 > c0 && elapsed_ns > 0) {
+        g_ns_per_tick.store(elapsed_ns / (double)(c1 - c0), std::memory_order_relaxed);
+    }
+#endif
+}
+
+// Lock-free histogram: bucket i holds samples with latency <= 2^i ns.
+// record_ns is one CLZ plus three relaxed atomic adds — safe from any
+// thread on the hot path.
+class LatencyHistogram {
+public:
+    static constexpr size_t NUM_BUCKETS = 32; // 2ns .. ~2.1s
+
+    std::atomic<uint64_t> buckets[NUM_BUCKETS] = {};
+    std::atomic<uint64_t> total_count{0};
+    std::atomic<uint64_t> total_sum_ns{0};
+
+    void record_ns(uint64_t ns) {
+        int b = 64 - __builtin_clzll(ns | 1); // ceil(log2), 0 maps to bucket 1
+        if (b >= (int)NUM_BUCKETS) b = NUM_BUCKETS - 1;
+        buckets[b].fetch_add(1, std::memory_order_relaxed);
+        total_count.fetch_add(1, std::memory_order_relaxed);
+        total_sum_ns.fetch_add(ns, std::memory_order_relaxed);
+    }
+
+    void record_ticks(uint64_t ticks) { record_ns(ticks_to_ns(ticks)); }
+
+    // Upper-bound estimate of the q-quantile (power-of-two bucket
+    // granularity, so accurate to within 2x — fine for replay reports).
+    uint64_t percentile_ns(double q) const {
+        uint64_t count = total_count.load(std::memory_order_relaxed);
+        if (count == 0) return 0;
+        uint64_t rank = (uint64_t)(q * (double)count);
+        if (rank >= count) rank = count - 1;
+        uint64_t cumulative = 0;
+        for (size_t i = 0; i < NUM_BUCKETS; ++i) {
+            cumulative += buckets[i].load(std::memory_order_relaxed);
+            if (cumulative > rank) return (1ULL << i);
+        }
+        return (1ULL << (NUM_BUCKETS - 1));
+    }
+
+    // Prometheus histogram exposition (cumulative le buckets, seconds).
+    void export_prometheus(std::ostringstream& out, const char* name, const char* help) const {
+        out << "# HELP " << name << " " << help << "\n";
+        out << "# TYPE " << name << " histogram\n";
+
+        uint64_t cumulative = 0;
+        for (size_t i = 0; i < NUM_BUCKETS; ++i) {
+            cumulative += buckets[i].load(std::memory_order_relaxed);
+            out << name << "_bucket{le=\"" << ((double)(1ULL << i) / 1e9) << "\"} "
+                << cumulative << "\n";
+        }
+        uint64_t count = total_count.load(std::memory_order_relaxed);
+        out << name << "_bucket{le=\"+Inf\"} " << count << "\n";
+        out << name << "_sum " << ((double)total_sum_ns.load(std::memory_order_relaxed) / 1e9) << "\n";
+        out << name << "_count " << count << "\n\n";
+    }
+};
+
+// Per-stage histograms
+static LatencyHistogram g_hist_parse;     // IsoParser::parse
+static LatencyHistogram g_hist_ipc_flush; // first buffered alert -> IPC batch flush
+static LatencyHistogram g_hist_evaluate;  // FastRiskEngine::evaluate
+static LatencyHistogram g_hist_ring_wait; // enqueue -> worker dequeue
+static LatencyHistogram g_hist_e2e;       // enqueue -> evaluation complete
+
+inline void record_parse_latency(uint64_t ticks) { g_hist_parse.record_ticks(ticks); }
+inline void record_ipc_flush_latency(uint64_t ticks) { g_hist_ipc_flush.record_ticks(ticks); }
+inline void record_evaluate_latency(uint64_t ticks) { g_hist_evaluate.record_ticks(ticks); }
+inline void record_ring_wait(uint64_t ticks) { g_hist_ring_wait.record_ticks(ticks); }
+inline void record_e2e_latency(uint64_t ticks) { g_hist_e2e.record_ticks(ticks); }
+
+// =============================================================================
+// Pipeline Stage Cycle Counters (/debug/stats)
+// =============================================================================
+
+// Raw TSC cycle accumulation per pipeline stage. Unlike the histograms
+// above (bucketed ns), these keep exact cycle and event totals, which is
+// what apportioning a throughput regression needs: average cycles per
+// stage answer "where did the budget go" without attaching perf to a
+// live box. Two relaxed adds per record — hot-path safe.
+enum Stage : int {
+    STAGE_KAFKA_POLL = 0,
+    STAGE_PARSE,
+    STAGE_RING_PUSH,
+    STAGE_RING_POP,
+    STAGE_EVALUATE,
+    STAGE_ALERT_FORMAT,
+    STAGE_ZMQ_SEND,
+    STAGE_COUNT
+};
+
+inline const char* stage_name(int s) {
+    static const char* const names[STAGE_COUNT] = {
+        "kafka_poll", "parse", "ring_push", "ring_pop",
+        "evaluate", "alert_format", "zmq_send"
+    };
+    return names[s];
+}
+
+struct StageCycles {
+    std::atomic<uint64_t> events{0};
+    std::atomic<uint64_t> cycles{0};
+};
+static StageCycles g_stage_cycles[STAGE_COUNT];
+
+inline void record_stage_cycles(Stage s, uint64_t ticks, uint64_t events = 1) {
+    g_stage_cycles[s].cycles.fetch_add(ticks, std::memory_order_relaxed);
+    g_stage_cycles[s].events.fetch_add(events, std::memory_order_relaxed);
+}
+
+// Ring occupancy: per-worker depth gauge plus a high-water mark, sampled
+// by each worker as it drains. Also feeds the aegis_ring_buffer_usage
+// gauge (deepest ring over capacity), which previously had no caller.
+static constexpr size_t MAX_TRACKED_RINGS = 8; // matches MAX_WORKERS
+static std::atomic<uint64_t> g_ring_depth[MAX_TRACKED_RINGS] = {};
+static std::atomic<uint64_t> g_ring_hwm[MAX_TRACKED_RINGS] = {};
+static std::atomic<uint64_t> g_ring_capacity{0};
+
+inline void record_ring_occupancy(size_t worker, size_t depth, size_t capacity) {
+    if (worker >= MAX_TRACKED_RINGS) return;
+    g_ring_depth[worker].store(depth, std::memory_order_relaxed);
+    uint64_t hwm = g_ring_hwm[worker].load(std::memory_order_relaxed);
+    while (depth > hwm &&
+           !g_ring_hwm[worker].compare_exchange_weak(hwm, depth,
+                                                     std::memory_order_relaxed)) {}
+    g_ring_capacity.store(capacity, std::memory_order_relaxed);
+
+    uint64_t deepest = 0;
+    for (size_t i = 0; i < MAX_TRACKED_RINGS; ++i) {
+        uint64_t d = g_ring_depth[i].load(std::memory_order_relaxed);
+        if (d > deepest) deepest = d;
+    }
+    update_ring_buffer_usage(deepest, capacity);
+}
+
+// Shard-lock contention: wait cycles accumulated around every shard mutex
+// acquisition on the evaluate miss path (the hit path takes no lock).
+static std::atomic<uint64_t> g_shard_lock_acquisitions{0};
+static std::atomic<uint64_t> g_shard_lock_wait_cycles{0};
+
+inline void record_shard_lock_wait(uint64_t ticks) {
+    g_shard_lock_acquisitions.fetch_add(1, std::memory_order_relaxed);
+    g_shard_lock_wait_cycles.fetch_add(ticks, std::memory_order_relaxed);
+}
+
+// Per-shard entry counts live in the risk engine; it registers a plain
+// function pointer (set from main) so this header stays independent of
+// risk_engine.hpp. The provider writes one JSON value.
+using ShardStatsFn = void (*)(std::ostringstream&);
+static ShardStatsFn g_shard_stats_fn = nullptr;
+inline void set_shard_stats_provider(ShardStatsFn fn) { g_shard_stats_fn = fn; }
+
 // =============================================================================
 // TPS Calculator (Called Periodically)
 // =============================================================================
@@ -129,13 +356,117 @@ inline std::string export_prometheus() {
 
     out << "# HELP aegis_drops_total Total messages dropped due to backpressure\n";
     out << "# TYPE aegis_drops_total counter\n";
-    out << "aegis_drops_total " << g_drops_total.load(std::memory_order_relaxed) << "\n";
+    out << "aegis_drops_total " << g_drops_total.load(std::memory_order_relaxed) << "\n\n";
+
+    out << "# HELP aegis_tcp_sink_drops_total Alerts dropped because the TCP sink outbox was full\n";
+    out << "# TYPE aegis_tcp_sink_drops_total counter\n";
+    out << "aegis_tcp_sink_drops_total " << g_tcp_sink_drops_total.load(std::memory_order_relaxed) << "\n\n";
+
+    out << "# HELP aegis_tcp_sink_reconnects_total TCP sink reconnects after a peer restart\n";
+    out << "# TYPE aegis_tcp_sink_reconnects_total counter\n";
+    out << "aegis_tcp_sink_reconnects_total " << g_tcp_sink_reconnects_total.load(std::memory_order_relaxed) << "\n\n";
+
+    out << "# HELP aegis_ipc_queue_depth Alerts buffered for the IPC sender (ring + staged batch)\n";
+    out << "# TYPE aegis_ipc_queue_depth gauge\n";
+    out << "aegis_ipc_queue_depth " << g_ipc_queue_depth.load(std::memory_order_relaxed) << "\n\n";
+
+    out << "# HELP aegis_lane_admitted_total Messages admitted to the worker rings per priority lane\n";
+    out << "# TYPE aegis_lane_admitted_total counter\n";
+    out << "aegis_lane_admitted_total{lane=\"high\"} " << g_lane_admitted_total[0].load(std::memory_order_relaxed) << "\n";
+    out << "aegis_lane_admitted_total{lane=\"low\"} " << g_lane_admitted_total[1].load(std::memory_order_relaxed) << "\n\n";
+
+    out << "# HELP aegis_lane_shed_total Messages shed by admission control per priority lane\n";
+    out << "# TYPE aegis_lane_shed_total counter\n";
+    out << "aegis_lane_shed_total{lane=\"high\"} " << g_lane_shed_total[0].load(std::memory_order_relaxed) << "\n";
+    out << "aegis_lane_shed_total{lane=\"low\"} " << g_lane_shed_total[1].load(std::memory_order_relaxed) << "\n\n";
+
+    g_hist_parse.export_prometheus(out, "aegis_parse_latency_seconds",
+        "ISO 20022 parse latency per message");
+    g_hist_evaluate.export_prometheus(out, "aegis_evaluate_latency_seconds",
+        "Risk engine evaluation latency per message");
+    g_hist_ring_wait.export_prometheus(out, "aegis_ring_wait_seconds",
+        "Ring buffer residency from enqueue to worker dequeue");
+    g_hist_e2e.export_prometheus(out, "aegis_e2e_latency_seconds",
+        "End-to-end latency from enqueue to evaluation complete");
+    g_hist_ipc_flush.export_prometheus(out, "aegis_ipc_flush_latency_seconds",
+        "Alert residency from first buffered alert to IPC batch flush");
+
+    return out.str();
+}
 
+// =============================================================================
+// /debug/stats JSON Export
+// =============================================================================
+
+// Structured introspection for incident triage: everything here is read
+// from the same lock-free counters the hot path writes, so serving the
+// endpoint perturbs nothing.
+inline std::string export_debug_json() {
+    double ns_per_tick = g_ns_per_tick.load(std::memory_order_relaxed);
+    std::ostringstream out;
+    out << "{\n  \"stages\": {";
+    for (int s = 0; s < STAGE_COUNT; ++s) {
+        uint64_t events = g_stage_cycles[s].events.load(std::memory_order_relaxed);
+        uint64_t cycles = g_stage_cycles[s].cycles.load(std::memory_order_relaxed);
+        double avg_cycles = events ? (double)cycles / (double)events : 0.0;
+        out << (s ? ", " : "")
+            << "\"" << stage_name(s) << "\": {"
+            << "\"events\": " << events
+            << ", \"cycles_total\": " << cycles
+            << ", \"avg_cycles\": " << avg_cycles
+            << ", \"avg_ns\": " << avg_cycles * ns_per_tick << "}";
+    }
+    out << "},\n";
+
+    out << "  \"rings\": {\"capacity\": "
+        << g_ring_capacity.load(std::memory_order_relaxed) << ", \"workers\": [";
+    for (size_t i = 0; i < MAX_TRACKED_RINGS; ++i) {
+        out << (i ? ", " : "")
+            << "{\"depth\": " << g_ring_depth[i].load(std::memory_order_relaxed)
+            << ", \"high_water\": " << g_ring_hwm[i].load(std::memory_order_relaxed) << "}";
+    }
+    out << "]},\n";
+
+    uint64_t lock_acq = g_shard_lock_acquisitions.load(std::memory_order_relaxed);
+    uint64_t lock_cycles = g_shard_lock_wait_cycles.load(std::memory_order_relaxed);
+    out << "  \"shard_locks\": {\"acquisitions\": " << lock_acq
+        << ", \"wait_cycles_total\": " << lock_cycles
+        << ", \"avg_wait_ns\": "
+        << (lock_acq ? (double)lock_cycles / (double)lock_acq * ns_per_tick : 0.0)
+        << "},\n";
+
+    struct Hist { const char* name; const LatencyHistogram* h; };
+    const Hist hists[] = {
+        {"parse",     &g_hist_parse},
+        {"evaluate",  &g_hist_evaluate},
+        {"ring_wait", &g_hist_ring_wait},
+        {"e2e",       &g_hist_e2e},
+        {"ipc_flush", &g_hist_ipc_flush},
+    };
+    out << "  \"latency_percentiles_ns\": {";
+    bool first = true;
+    for (const Hist& h : hists) {
+        out << (first ? "" : ", ")
+            << "\"" << h.name << "\": {"
+            << "\"p50\": " << h.h->percentile_ns(0.50)
+            << ", \"p99\": " << h.h->percentile_ns(0.99)
+            << ", \"p999\": " << h.h->percentile_ns(0.999) << "}";
+        first = false;
+    }
+    out << "},\n";
+
+    out << "  \"shards\": ";
+    if (g_shard_stats_fn) {
+        g_shard_stats_fn(out);
+    } else {
+        out << "null";
+    }
+    out << "\n}\n";
     return out.str();
 }
 
 // =============================================================================
-// Minimal HTTP Server for /metrics Endpoint
+// Minimal HTTP Server for /metrics and /debug/stats
 // =============================================================================
 
 class MetricsServer {
@@ -173,6 +504,7 @@ public:
 
 private:
     void serve() {
+        ThreadPlacement::pin_current(Role::Metrics, 0);
 #ifdef _WIN32
         WSADATA wsaData;
         WSAStartup(MAKEWORD(2, 2), &wsaData);
@@ -224,18 +556,24 @@ private:
 
             if (client_fd < 0) continue;
 
-            // Read request (we don't really parse it, just serve /metrics)
+            // Read just enough of the request line to route; anything
+            // that is not /debug/stats serves /metrics as before.
             char buffer[1024];
-            recv(client_fd, buffer, sizeof(buffer) - 1, 0);
+            int nread = recv(client_fd, buffer, sizeof(buffer) - 1, 0);
+            if (nread < 0) nread = 0;
+            buffer[nread] = '\0';
+            bool debug = strstr(buffer, "GET /debug/stats") != nullptr;
 
             // Update TPS before serving
             calculate_tps();
 
             // Generate response
-            std::string body = export_prometheus();
+            std::string body = debug ? export_debug_json() : export_prometheus();
             std::ostringstream response;
             response << "HTTP/1.1 200 OK\r\n";
-            response << "Content-Type: text/plain; charset=utf-8\r\n";
+            response << "Content-Type: "
+                     << (debug ? "application/json" : "text/plain; charset=utf-8")
+                     << "\r\n";
             response << "Content-Length: " << body.size() << "\r\n";
             response << "\r\n";
             response << body;
@@ -256,6 +594,7 @@ private:
 static std::unique_ptr<MetricsServer> g_metrics_server;
 
 inline void init(int port = 9090) {
+    calibrate_tsc();
     g_metrics_server = std::make_unique<MetricsServer>(port);
     g_metrics_server->start();
 }
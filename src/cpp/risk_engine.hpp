@@ -2,8 +2,8 @@
  * Project Aegis - Fast Risk Engine
  * Deterministic Inference with Hot-Swappable Rules.
  *
- * ENTERPRISE REFACTOR (v8.1 - High Performance):
- * 1. Standard Library Containers (std::unordered_map).
+ * ENTERPRISE REFACTOR (v8.3 - High Performance):
+ * 1. Open-Addressing Flat Shard Tables (Inline Keys, No Node Allocation).
  * 2. SHARDED LOCKING (1024 Mutexes) - Solves Global Lock Bottleneck.
  * 3. False Sharing Prevention (Padding).
  */
@@ -12,20 +12,51 @@
 #define RISK_ENGINE_HPP
 
 #include "hft_core.hpp"
+#include "metrics.hpp"
 #include <atomic>
 #include <fstream>
 #include <iostream>
 #include <chrono>
-#include <unordered_map>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <array>
+#include <thread>
+#include <unordered_map>
 
 // --- MOCK EXTERNAL STORAGE (Redis/Ignite) ---
+// In-process stand-in for the off-box cache: cold entities spilled here
+// survive eviction and are restored on the next miss. The interface is
+// what a real Redis/Ignite adapter would implement.
 class DistrubutedCache {
 public:
-    static EntityState fetch_from_redis(const std::string& key) {
-        return EntityState();
+    struct TieredEntry {
+        uint64_t last_seen;
+        float velocity;
+        float structuring;
+    };
+
+    static void spill(const std::string& key, const TieredEntry& entry) {
+        std::lock_guard<std::mutex> lock(store_mtx());
+        store()[key] = entry;
+    }
+
+    static bool fetch(const std::string& key, TieredEntry& out) {
+        std::lock_guard<std::mutex> lock(store_mtx());
+        auto it = store().find(key);
+        if (it == store().end()) return false;
+        out = it->second;
+        return true;
+    }
+
+private:
+    static std::unordered_map<std::string, TieredEntry>& store() {
+        static std::unordered_map<std::string, TieredEntry> s;
+        return s;
+    }
+    static std::mutex& store_mtx() {
+        static std::mutex m;
+        return m;
     }
 };
 
@@ -42,39 +73,357 @@ struct ModelWeights {
 // Power of 2 for fast modulus.
 constexpr size_t RISK_MAP_SHARDS = 1024;
 
+// Open-addressing flat table for one shard.
+// Keyed by the 64-bit FNV1a hash with inline key bytes for verification:
+// no std::string, no node allocation, probes walk contiguous memory.
+class FlatEntityMap {
+public:
+    // Power of 2, ~2x MAX_OCCUPANCY so max load factor stays < 0.5.
+    static constexpr size_t CAPACITY = 1024;
+    static constexpr size_t MAX_OCCUPANCY = 500; // hard per-shard entity bound
+    static constexpr size_t KEY_CAP = 64;   // matches PaymentData name fields
+    static constexpr size_t MAX_PROBE = 64; // deterministic probe bound
+
+    struct Slot {
+        // 0 = empty (real hashes are normalized to != 0). Atomic because
+        // the read path probes without the shard lock: writers fill the
+        // key bytes first and release-store the hash to publish the slot;
+        // recycling a slot release-stores 0 first so lock-free probes miss
+        // and fall through to the locked path while the key is rewritten.
+        std::atomic<uint64_t> hash{0};
+        std::atomic<uint8_t> ref{0}; // clock/second-chance bit, set on access
+        char key[KEY_CAP] = {0};
+        EntityState state;
+    };
+
+    // Snapshot of a demoted entry, handed to the async spill path.
+    struct Evicted {
+        char key[KEY_CAP];
+        uint64_t last_seen;
+        float velocity;
+        float structuring;
+        bool valid;
+    };
+
+private:
+    // Slot storage comes from the huge-page arena when it is enabled (the
+    // arena never frees; the deleter only releases heap-fallback blocks).
+    using SlotPtr = std::unique_ptr<Slot[], void (*)(Slot*)>;
+    static void free_slots(Slot* p) {
+        if (!HugePageArena::global().owns(p)) delete[] p;
+    }
+
+    SlotPtr slots;
+    size_t count = 0;
+
+    static bool key_matches(const Slot& s, const char* key, size_t key_len) {
+        return memcmp(s.key, key, key_len) == 0 && s.key[key_len] == '\0';
+    }
+
+    static bool same_partition(uint64_t a, uint64_t b, size_t partitions) {
+        return partitions <= 1 || (a % partitions) == (b % partitions);
+    }
+
+public:
+    FlatEntityMap() : slots(HugePageArena::global().create_array<Slot>(CAPACITY), &free_slots) {}
+
+    size_t size() const { return count; }
+
+    // Copies every published slot's detection state into `out` (capped at
+    // `max`), reusing the spill record shape. Caller holds the shard lock,
+    // so this is the copy side of copy-on-write checkpointing: the lock is
+    // held only for a bounded memcpy sweep (<= MAX_OCCUPANCY records), and
+    // serialization happens on the checkpoint thread afterwards.
+    size_t export_live(Evicted* out, size_t max) const {
+        size_t n = 0;
+        for (size_t i = 0; i < CAPACITY && n < max; ++i) {
+            const Slot& s = slots[i];
+            if (s.hash.load(std::memory_order_relaxed) == 0) continue;
+            memcpy(out[n].key, s.key, KEY_CAP);
+            out[n].last_seen = s.state.last_seen_timestamp.load(std::memory_order_relaxed);
+            out[n].velocity = s.state.velocity_accumulator.load(std::memory_order_relaxed);
+            out[n].structuring = s.state.structuring_score.load(std::memory_order_relaxed);
+            out[n].valid = true;
+            n++;
+        }
+        return n;
+    }
+
+    // Startup-only: walk the slot array a page at a time so the whole
+    // probe surface is resident (and in the TLB) before the first real
+    // message. Slots are zero-written at construction, so a read per page
+    // is enough here; the volatile sink keeps the loop from folding away.
+    void prefault() const {
+        volatile uint64_t sink;
+        const size_t stride = 4096 / sizeof(Slot) ? 4096 / sizeof(Slot) : 1;
+        for (size_t i = 0; i < CAPACITY; i += stride) {
+            sink = slots[i].hash.load(std::memory_order_relaxed);
+        }
+        (void)sink;
+    }
+
+    static uint64_t normalize_hash(uint64_t h) { return h ? h : 1; }
+
+    // Lookup only; nullptr if absent. Safe without the shard lock: probes
+    // acquire-load each slot's hash, and writers publish slots hash-last
+    // (and unpublish hash-first on recycle), so a matching hash implies
+    // fully written key bytes. A race with recycling at worst returns a
+    // miss, never a torn slot; the caller then takes the locked path.
+    EntityState* find(uint64_t h, const char* key, size_t key_len) {
+        h = normalize_hash(h);
+        if (key_len > KEY_CAP - 1) key_len = KEY_CAP - 1;
+
+        size_t idx = h & (CAPACITY - 1);
+        for (size_t probe = 0; probe < MAX_PROBE; ++probe) {
+            Slot& s = slots[idx];
+            uint64_t slot_hash = s.hash.load(std::memory_order_acquire);
+            if (slot_hash == 0) return nullptr;
+            if (slot_hash == h && key_matches(s, key, key_len)) {
+                s.ref.store(1, std::memory_order_relaxed);
+                return &s.state;
+            }
+            idx = (idx + 1) & (CAPACITY - 1);
+        }
+        return nullptr;
+    }
+
+    // Lookup or claim an empty slot (linear probing).
+    // Returns nullptr when the probe window is exhausted (shard full).
+    EntityState* find_or_insert(uint64_t h, const char* key, size_t key_len, bool& inserted) {
+        h = normalize_hash(h);
+        if (key_len > KEY_CAP - 1) key_len = KEY_CAP - 1;
+        inserted = false;
+
+        size_t idx = h & (CAPACITY - 1);
+        for (size_t probe = 0; probe < MAX_PROBE; ++probe) {
+            Slot& s = slots[idx];
+            uint64_t slot_hash = s.hash.load(std::memory_order_relaxed);
+            if (slot_hash == 0) {
+                claim_slot(s, h, key, key_len);
+                inserted = true;
+                return &s.state;
+            }
+            if (slot_hash == h && key_matches(s, key, key_len)) {
+                s.ref.store(1, std::memory_order_relaxed);
+                return &s.state;
+            }
+            idx = (idx + 1) & (CAPACITY - 1);
+        }
+        return nullptr;
+    }
+
+    // Insert with tiered-storage semantics: when the shard is at its
+    // occupancy bound or the probe window is full, a cold victim inside the
+    // window is demoted (clock/second-chance: a set ref bit buys one pass)
+    // and its slot reused. Overwriting occupied slots never breaks probe
+    // chains, so the cost is bounded by MAX_PROBE.
+    //
+    // Recycling re-tenants a slot, and the hit path updates EntityState
+    // with no lock held — so a victim is only eligible if it belongs to
+    // the inserting entity's worker partition (hash % partitions, the
+    // same modulus ingress uses to route entities to workers). The only
+    // thread that could be mid-update on such a slot is the caller
+    // itself, which is here inserting; a live pointer held by ANOTHER
+    // worker is therefore never re-tenanted under it, regardless of
+    // ref-bit timing. A referenced slot is never evicted either — the
+    // sweep clears ref bits and fails the insert with nullptr instead,
+    // so the demotion happens on a LATER miss once a victim has gone a
+    // full sweep untouched. Callers treat nullptr as a transient
+    // shard-full.
+    EntityState* find_or_insert_evicting(uint64_t h, const char* key, size_t key_len,
+                                         bool& inserted, Evicted& evicted,
+                                         size_t partitions = 1) {
+        h = normalize_hash(h);
+        if (key_len > KEY_CAP - 1) key_len = KEY_CAP - 1;
+        inserted = false;
+        evicted.valid = false;
+
+        size_t idx = h & (CAPACITY - 1);
+        Slot* first_empty = nullptr;
+        Slot* victim = nullptr;
+
+        for (size_t probe = 0; probe < MAX_PROBE; ++probe) {
+            Slot& s = slots[idx];
+            uint64_t slot_hash = s.hash.load(std::memory_order_relaxed);
+            if (slot_hash == 0) {
+                if (!first_empty) first_empty = &s;
+            } else {
+                if (slot_hash == h && key_matches(s, key, key_len)) {
+                    s.ref.store(1, std::memory_order_relaxed);
+                    return &s.state;
+                }
+                // Clock sweep, restricted to this partition's slots: the
+                // first already-cold one becomes the victim; the rest
+                // merely lose their second chance.
+                if (!victim && same_partition(slot_hash, h, partitions)) {
+                    if (s.ref.load(std::memory_order_relaxed) == 0) {
+                        victim = &s;
+                    } else {
+                        s.ref.store(0, std::memory_order_relaxed);
+                    }
+                }
+            }
+            idx = (idx + 1) & (CAPACITY - 1);
+        }
+
+        if (first_empty && count < MAX_OCCUPANCY) {
+            claim_slot(*first_empty, h, key, key_len);
+            inserted = true;
+            return &first_empty->state;
+        }
+        if (!victim) return nullptr;
+
+        // Demote the victim and hand its state to the spill path.
+        memcpy(evicted.key, victim->key, KEY_CAP);
+        evicted.last_seen = victim->state.last_seen_timestamp.load(std::memory_order_relaxed);
+        evicted.velocity = victim->state.velocity_accumulator.load(std::memory_order_relaxed);
+        evicted.structuring = victim->state.structuring_score.load(std::memory_order_relaxed);
+        evicted.valid = true;
+
+        // Unpublish before rewriting so concurrent lock-free probes see a
+        // miss (and take the locked path) instead of a half-written key.
+        victim->hash.store(0, std::memory_order_release);
+        victim->ref.store(1, std::memory_order_relaxed);
+        memcpy(victim->key, key, key_len);
+        victim->key[key_len] = '\0';
+        victim->state.last_seen_timestamp.store(0, std::memory_order_relaxed);
+        victim->state.reset_window();
+        victim->state.structuring_score.store(0.0f, std::memory_order_relaxed);
+        victim->hash.store(h, std::memory_order_release);
+
+        inserted = true; // new key: caller should attempt a tiered re-fetch
+        return &victim->state;
+    }
+
+private:
+    void claim_slot(Slot& s, uint64_t h, const char* key, size_t key_len) {
+        // Key bytes first, hash last: the release store publishes the slot
+        // to lock-free readers only once it is fully written.
+        s.ref.store(1, std::memory_order_relaxed);
+        memcpy(s.key, key, key_len);
+        s.key[key_len] = '\0';
+        s.hash.store(h, std::memory_order_release);
+        count++;
+    }
+};
+
 class FastRiskEngine {
 public:
     // SHARD STRUCTURE
     // Align to 64 bytes to prevent "False Sharing" of mutexes on adjacent cache lines.
     struct alignas(64) RiskShard {
         std::mutex mtx;
-        std::unordered_map<std::string, EntityState> map;
+        FlatEntityMap map;
         // Padding is implicit due to alignas(64), but ensures each mutex is on its own line.
     };
 
     std::array<RiskShard, RISK_MAP_SHARDS> shards;
 
     // TIER 2: LIMITS (Per Shard approx)
-    static constexpr size_t MAX_ENTRIES_PER_SHARD = 500; // 500 * 1024 = 512k Total
+    static constexpr size_t MAX_ENTRIES_PER_SHARD = FlatEntityMap::MAX_OCCUPANCY; // 500 * 1024 = 512k Total
+
+    // TIERED STORAGE (Async Spill Path)
+    // Evicted entries are queued here and flushed to the external cache by
+    // a background thread, keeping the hot path free of cache round-trips.
+    MpmcRingBuffer<FlatEntityMap::Evicted, 4096> spill_ring; // N workers push lock-free
+    std::thread spill_thread;
+    std::atomic<bool> tiering_running{false};
 
     // Double Buffered Rules
     ModelWeights rule_sets[2];
     std::atomic<int> active_idx{0};
 
-    FastRiskEngine() {
-        // Reserve per shard
-        for(auto& shard : shards) {
-            shard.map.reserve(MAX_ENTRIES_PER_SHARD);
-        }
+    // Worker partition modulus for eviction safety (see
+    // FlatEntityMap::find_or_insert_evicting): must match the ingress
+    // router's worker count and be set before workers start. The default
+    // of 1 means "single writer" — any victim is eligible.
+    size_t worker_partitions = 1;
+    void set_worker_partitions(size_t n) { worker_partitions = n ? n : 1; }
 
+    FastRiskEngine() {
+        // Shard tables are preallocated flat arrays (FlatEntityMap ctor).
         rule_sets[0] = {0.6f, 0.25f, 5.0f, 9000.0f, 0.05f};
         rule_sets[1] = {0.6f, 0.25f, 5.0f, 9000.0f, 0.05f};
     }
 
-    void reload_rules(const char* json_path) {
+    ~FastRiskEngine() {
+        stop_tiering();
+    }
+
+    void start_tiering() {
+        if (tiering_running.load()) return;
+        tiering_running.store(true);
+        spill_thread = std::thread(&FastRiskEngine::spill_loop, this);
+    }
+
+    void stop_tiering() {
+        tiering_running.store(false);
+        if (spill_thread.joinable()) spill_thread.join();
+    }
+
+    // Parses the flat model_weights.json schema into ModelWeights.
+    // Unknown keys (e.g. amount_weight, reserved for a future model) are
+    // ignored; all mapped keys are required and validated. Returns false
+    // without touching `out` on any parse or validation failure.
+    static bool parse_weights_json(const std::string& text, ModelWeights& out) {
+        ModelWeights w;
+        struct Field { const char* key; float* dst; float min; float max; };
+        const Field fields[] = {
+            {"velocity_weight",       &w.velocity_weight,       0.0f, 1.0f},
+            {"structuring_weight",    &w.structuring_weight,    0.0f, 1.0f},
+            {"velocity_threshold_1h", &w.velocity_threshold,    0.0f, 1e9f},
+            {"structuring_threshold", &w.structuring_threshold, 0.0f, 1e9f},
+            {"baseline_risk",         &w.baseline,              0.0f, 1.0f},
+        };
+
+        for (const Field& f : fields) {
+            std::string needle = std::string("\"") + f.key + "\"";
+            size_t pos = text.find(needle);
+            if (pos == std::string::npos) return false;
+            pos = text.find(':', pos + needle.size());
+            if (pos == std::string::npos) return false;
+
+            const char* p = text.c_str() + pos + 1;
+            char* end = nullptr;
+            double v = strtod(p, &end);
+            if (end == p) return false;
+            if (v < (double)f.min || v > (double)f.max) return false;
+            *f.dst = (float)v;
+        }
+
+        // Thresholds of zero make every payment trip the rule.
+        if (w.velocity_threshold <= 0.0f || w.structuring_threshold <= 0.0f) return false;
+
+        out = w;
+        return true;
+    }
+
+    // Reads, parses and validates json_path, then publishes through the
+    // double buffer: the inactive set is written and active_idx flipped
+    // with release semantics, so the hot path never blocks and never sees
+    // a half-written rule set. On any failure the active rules stay live.
+    bool reload_rules(const char* json_path) {
+        std::ifstream file(json_path);
+        if (!file) {
+            printf("[RULES] Cannot open %s; keeping active rule set.\n", json_path);
+            return false;
+        }
+        std::string text((std::istreambuf_iterator<char>(file)),
+                         std::istreambuf_iterator<char>());
+
+        ModelWeights w;
+        if (!parse_weights_json(text, w)) {
+            printf("[RULES] Rejected %s (malformed or out-of-range); keeping active rule set.\n", json_path);
+            return false;
+        }
+
         int next_idx = !active_idx.load();
-        rule_sets[next_idx] = {0.8f, 0.1f, 3.0f, 8000.0f, 0.05f};
+        rule_sets[next_idx] = w;
         active_idx.store(next_idx, std::memory_order_release);
+        printf("[RULES] Published new weights: vel_w=%.2f struct_w=%.2f vel_thr=%.1f struct_thr=%.0f base=%.2f\n",
+               w.velocity_weight, w.structuring_weight, w.velocity_threshold,
+               w.structuring_threshold, w.baseline);
+        return true;
     }
 
     struct RiskResult {
@@ -82,14 +431,96 @@ public:
         bool is_blocked;
     };
 
+    // Startup pre-warm: touch every shard's slot pages before ingress
+    // starts. The flat maps never rehash (capacity is fixed at
+    // construction), so cold-start cost here is page faults and TLB
+    // misses, not growth — this pays both up front.
+    void prewarm_touch() const {
+        for (const RiskShard& shard : shards) shard.map.prefault();
+    }
+
+    // Startup pre-warm: place a known-hot entity in its shard map (locked
+    // slow path, no contention at startup) so it takes the lock-free hit
+    // path from its first real message. Pulls spilled state back from the
+    // tiering cache when present; no velocity is invented otherwise.
+    void prewarm_entity(const char* entity_name, size_t name_len) {
+        uint64_t h = fnv1a_hash(entity_name, name_len);
+        RiskShard& shard = shards[h & (RISK_MAP_SHARDS - 1)];
+        std::lock_guard<std::mutex> lock(shard.mtx);
+
+        bool inserted = false;
+        FlatEntityMap::Evicted evicted;
+        evicted.valid = false;
+        EntityState* state = shard.map.find_or_insert_evicting(
+            h, entity_name, name_len, inserted, evicted, worker_partitions);
+        if (!state) return; // probe window pinned; this name warms on first traffic
+        if (inserted) {
+            DistrubutedCache::TieredEntry cold;
+            size_t klen = (name_len < FlatEntityMap::KEY_CAP - 1) ? name_len : FlatEntityMap::KEY_CAP - 1;
+            if (DistrubutedCache::fetch(std::string(entity_name, klen), cold)) {
+                state->last_seen_timestamp.store(cold.last_seen, std::memory_order_relaxed);
+                state->seed_velocity(cold.velocity,
+                    (uint64_t)std::chrono::steady_clock::now().time_since_epoch().count());
+                state->structuring_score.store(cold.structuring, std::memory_order_relaxed);
+            }
+        }
+        if (evicted.valid) spill_ring.push(evicted);
+    }
+
+    // Per-shard occupancy for the /debug/stats endpoint. Counts are read
+    // without the shard locks: size() is refreshed under lock by writers,
+    // and a slightly stale number is fine for introspection.
+    void export_shard_stats_json(std::ostringstream& out) const {
+        size_t total = 0, occupied = 0, hottest = 0;
+        out << "{\"per_shard_entries\": [";
+        for (size_t i = 0; i < RISK_MAP_SHARDS; ++i) {
+            size_t n = shards[i].map.size();
+            total += n;
+            if (n > 0) occupied++;
+            if (n > hottest) hottest = n;
+            out << (i ? "," : "") << n;
+        }
+        out << "], \"entries_total\": " << total
+            << ", \"occupied_shards\": " << occupied
+            << ", \"hottest_shard_entries\": " << hottest
+            << ", \"shard_entry_cap\": " << FlatEntityMap::MAX_OCCUPANCY << "}";
+    }
+
+    // Checkpoint restore: re-seat an entity with the detection state it
+    // carried at snapshot time (see checkpoint.hpp). Same seeding
+    // semantics as a tiered re-fetch: the spilled rolling sum lands in
+    // the current bucket and decays out over the window.
+    void restore_entity(const char* entity_name, size_t name_len,
+                        uint64_t last_seen, float velocity, float structuring) {
+        uint64_t h = fnv1a_hash(entity_name, name_len);
+        RiskShard& shard = shards[h & (RISK_MAP_SHARDS - 1)];
+        std::lock_guard<std::mutex> lock(shard.mtx);
+
+        bool inserted = false;
+        FlatEntityMap::Evicted evicted;
+        evicted.valid = false;
+        EntityState* state = shard.map.find_or_insert_evicting(
+            h, entity_name, name_len, inserted, evicted, worker_partitions);
+        if (!state) {
+            // Probe window pinned: park the record in the spill tier
+            // instead, so the entity's first miss re-fetches its state.
+            size_t klen = (name_len < FlatEntityMap::KEY_CAP - 1) ? name_len : FlatEntityMap::KEY_CAP - 1;
+            DistrubutedCache::spill(std::string(entity_name, klen),
+                                    {last_seen, velocity, structuring});
+            return;
+        }
+        state->last_seen_timestamp.store(last_seen, std::memory_order_relaxed);
+        state->seed_velocity(velocity,
+            (uint64_t)std::chrono::steady_clock::now().time_since_epoch().count());
+        state->structuring_score.store(structuring, std::memory_order_relaxed);
+        if (evicted.valid) spill_ring.push(evicted);
+    }
+
     // FNV1a Hash for Shard Selection (Wait-Free)
+    // Shared definition lives in hft_core.hpp; the ingress router uses the
+    // same hash so a worker only ever touches "its" entities.
     static constexpr uint64_t fnv1a_hash(const char* str, size_t len) {
-        uint64_t hash = 14695981039346656037ULL;
-        for (size_t i = 0; i < len; ++i) {
-            hash ^= static_cast<unsigned char>(str[i]);
-            hash *= 1099511628211ULL;
-        }
-        return hash;
+        return ::fnv1a_hash(str, len);
     }
 
     RiskResult evaluate(const char* entity_name, size_t name_len, int64_t amount) {
@@ -98,44 +529,80 @@ public:
         size_t shard_idx = h & (RISK_MAP_SHARDS - 1);
         RiskShard& shard = shards[shard_idx];
 
-        std::string key(entity_name, name_len);
-
         // 2. Load Rules (Atomic)
         int idx = active_idx.load(std::memory_order_acquire);
         const ModelWeights& w = rule_sets[idx];
 
-        // 3. Lock ONLY the Shard
-        std::unique_lock<std::mutex> lock(shard.mtx);
-
-        auto& risk_map = shard.map;
-        auto it = risk_map.find(key);
-
-        if (it == risk_map.end()) {
-            if (risk_map.size() >= MAX_ENTRIES_PER_SHARD) {
-                // Tiered Storage Logic (Mocked)
-                // Just proceed for now to avoid complexity in this demo file
+        // 3. Lock-Free Hit Path
+        // Ingress partitions by the same FNV1a hash the shards use, so a
+        // given entity is only ever evaluated by one worker: its state
+        // never sees concurrent updates. The shard mutex therefore only
+        // guards table structure, and a probe that finds a published slot
+        // (see FlatEntityMap::find) can update it with no lock at all.
+        // Nor can recycling pull that slot out from under us: eviction is
+        // restricted to victims in the evicting entity's own worker
+        // partition (see find_or_insert_evicting), and this worker — the
+        // only one whose miss could target this slot — is busy right here.
+        // Under skewed traffic the hot debtors live permanently on this
+        // path and the shard mutex drops out of their profile.
+        FlatEntityMap::Evicted evicted;
+        evicted.valid = false;
+        EntityState* found = shard.map.find(h, entity_name, name_len);
+        if (!found) {
+            // Miss: structural change needed — take the shard lock.
+            // Wait time is accumulated for /debug/stats: a rising average
+            // here means the miss path is contended, not the hit path.
+            uint64_t t_lock = Metrics::now_ticks();
+            std::lock_guard<std::mutex> lock(shard.mtx);
+            Metrics::record_shard_lock_wait(Metrics::now_ticks() - t_lock);
+
+            // The shard-selection hash doubles as the table key: no
+            // std::string construction, no node allocation, inline key
+            // verification.
+            bool inserted = false;
+            EntityState* state = shard.map.find_or_insert_evicting(
+                h, entity_name, name_len, inserted, evicted, worker_partitions);
+
+            if (state && inserted) {
+                // Lazy re-fetch: the entity may have been demoted earlier.
+                // Miss path only, so the std::string key is off the fast path.
+                DistrubutedCache::TieredEntry cold;
+                size_t klen = (name_len < FlatEntityMap::KEY_CAP - 1) ? name_len : FlatEntityMap::KEY_CAP - 1;
+                if (DistrubutedCache::fetch(std::string(entity_name, klen), cold)) {
+                    state->last_seen_timestamp.store(cold.last_seen, std::memory_order_relaxed);
+                    // Spilled sum seeds the current bucket and decays out
+                    // naturally; the detailed bucket history isn't spilled.
+                    state->seed_velocity(cold.velocity,
+                        (uint64_t)std::chrono::steady_clock::now().time_since_epoch().count());
+                    state->structuring_score.store(cold.structuring, std::memory_order_relaxed);
+                }
             }
-
-            // EntityState contains atomics and is not copyable. Construct in-place.
-            it = risk_map.try_emplace(key).first;
+            found = state;
         }
 
-        EntityState& state = it->second;
-
-        // 4. Update Logic (Inside Shard Lock)
+        // 4. Update Logic (No Lock)
+        // Safe out of the lock: this worker is the entity's only writer
+        // (hash partitioning above). Rolling-window velocity: no hard
+        // reset to straddle or pace around (see EntityState).
         long now_ns = std::chrono::steady_clock::now().time_since_epoch().count();
-        uint64_t last_seen = state.last_seen_timestamp.load(std::memory_order_relaxed);
-
-        if ((now_ns - last_seen) > 1000000000ULL) {
-             state.velocity_accumulator.store(0.0f, std::memory_order_relaxed);
+        float v;
+        if (found) {
+            found->last_seen_timestamp.store(now_ns, std::memory_order_relaxed);
+            v = found->update_velocity((uint64_t)now_ns);
+        } else {
+            // Insert failed: the probe window holds only hot or foreign-
+            // owned slots. Score this event statelessly (velocity of one,
+            // nothing tracked) rather than recycle a slot another worker
+            // may be mid-update on; the entity retries on its next payment.
+            v = 1.0f;
         }
 
-        state.last_seen_timestamp.store(now_ns, std::memory_order_relaxed);
-        float v = state.velocity_accumulator.load(std::memory_order_relaxed);
-        v += 1.0f;
-        state.velocity_accumulator.store(v, std::memory_order_relaxed);
-
-        lock.unlock(); // Release lock quickly
+        // Queue the demoted entry for async spill (outside the shard lock).
+        // Best-effort: if the spill ring is full the cold state is dropped,
+        // which only costs accuracy on an already-cold entity.
+        if (evicted.valid) {
+            spill_ring.push(evicted);
+        }
 
         // 5. Inference (Wait-Free math)
         float velocity_score = (v > w.velocity_threshold * 2) ? 1.0f : (v / (w.velocity_threshold * 2));
@@ -157,6 +624,27 @@ public:
 
         return { total_risk, (total_risk > 0.8f) };
     }
+
+private:
+    void spill_loop() {
+        FlatEntityMap::Evicted rec;
+        while (tiering_running.load(std::memory_order_relaxed)) {
+            bool drained_any = false;
+            while (spill_ring.pop(rec)) {
+                DistrubutedCache::spill(std::string(rec.key),
+                                        {rec.last_seen, rec.velocity, rec.structuring});
+                drained_any = true;
+            }
+            if (!drained_any) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+        // Final drain on shutdown so queued demotions are not lost.
+        while (spill_ring.pop(rec)) {
+            DistrubutedCache::spill(std::string(rec.key),
+                                    {rec.last_seen, rec.velocity, rec.structuring});
+        }
+    }
 };
 
 #endif
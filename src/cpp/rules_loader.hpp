@@ -1,25 +1,44 @@
 /*
  * Project Aegis - Rules Loader
- * Watches configuration file and triggers engine update.
+ * Watches model_weights.json and hot-swaps engine weights.
+ *
+ * Linux uses inotify on the config file's directory (editors and config
+ * pushers typically write-and-rename, so watching the file inode alone
+ * misses replacements); elsewhere it falls back to mtime polling. Parsed
+ * weights publish through the engine's double-buffered rule sets, so a
+ * reload never blocks the hot path and a bad file never unloads the
+ * active rules.
  */
 
 #ifndef RULES_LOADER_HPP
 #define RULES_LOADER_HPP
 
 #include "risk_engine.hpp"
+#include <string>
 #include <thread>
 #include <chrono>
 
+#include <sys/stat.h>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
 class RulesLoader {
     FastRiskEngine& engine;
     std::thread watcher_thread;
-    bool running = false;
+    std::atomic<bool> running{false};
 
 public:
     RulesLoader(FastRiskEngine& eng) : engine(eng) {}
 
     void start(const std::string& path) {
         running = true;
+        // Initial load so the engine starts on the configured weights
+        // rather than the compiled-in defaults.
+        engine.reload_rules(path.c_str());
         watcher_thread = std::thread(&RulesLoader::watch_loop, this, path);
     }
 
@@ -29,14 +48,73 @@ public:
     }
 
 private:
+#ifdef __linux__
     void watch_loop(std::string path) {
-        // Simulating file watch
-        // In prod: use inotify (Linux) or ReadDirectoryChangesW (Windows)
-        while (running && !force_quit) {
-            std::this_thread::sleep_for(std::chrono::seconds(2));
+        // Watch the directory, not the file: config pushers write-and-
+        // rename, which replaces the inode a file watch is bound to.
+        std::string dir = ".";
+        std::string fname = path;
+        size_t slash = path.find_last_of('/');
+        if (slash != std::string::npos) {
+            dir = path.substr(0, slash);
+            fname = path.substr(slash + 1);
+        }
+
+        int ifd = inotify_init1(IN_NONBLOCK);
+        if (ifd < 0) {
+            printf("[RULES] inotify unavailable; falling back to polling.\n");
+            poll_loop(path);
+            return;
+        }
+        int wd = inotify_add_watch(ifd, dir.c_str(),
+                                   IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+        if (wd < 0) {
+            printf("[RULES] Cannot watch %s; falling back to polling.\n", dir.c_str());
+            close(ifd);
+            poll_loop(path);
+            return;
+        }
+        printf("[RULES] Watching %s for weight updates (inotify).\n", path.c_str());
 
-            // For Demo: Trigger reload every few seconds
-            // engine.reload_rules(path.c_str());
+        alignas(alignof(struct inotify_event)) char buf[4096];
+        while (running.load(std::memory_order_relaxed) && !force_quit) {
+            struct pollfd pfd = { ifd, POLLIN, 0 };
+            int pr = poll(&pfd, 1, 500); // bounded wait so stop() is honored
+            if (pr <= 0) continue;
+
+            ssize_t len = read(ifd, buf, sizeof(buf));
+            if (len <= 0) continue;
+
+            bool matched = false;
+            for (char* p = buf; p < buf + len; ) {
+                struct inotify_event* ev = (struct inotify_event*)p;
+                if (ev->len > 0 && fname == ev->name) matched = true;
+                p += sizeof(struct inotify_event) + ev->len;
+            }
+            if (matched) {
+                // Let a write-then-chmod sequence settle; a torn write is
+                // rejected by validation and the active set stays live.
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                engine.reload_rules(path.c_str());
+            }
+        }
+        close(ifd);
+    }
+#else
+    void watch_loop(std::string path) { poll_loop(path); }
+#endif
+
+    // Portable fallback: reload when the file's mtime changes.
+    void poll_loop(const std::string& path) {
+        long last_mtime = 0;
+        while (running.load(std::memory_order_relaxed) && !force_quit) {
+            std::this_thread::sleep_for(std::chrono::seconds(2));
+            struct stat st;
+            if (stat(path.c_str(), &st) != 0) continue;
+            if ((long)st.st_mtime != last_mtime) {
+                last_mtime = (long)st.st_mtime;
+                engine.reload_rules(path.c_str());
+            }
         }
     }
 };
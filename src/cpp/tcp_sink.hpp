@@ -0,0 +1,216 @@
+/*
+ * Project Aegis - TCP Alert Sink
+ * Connected compliance feed: outbox thread, writev framing, reconnect.
+ *
+ * Replaces SimpleTcpClient, which did a blocking connect, two send()
+ * syscalls per message and left the socket in an undefined state after a
+ * peer restart. The sink never runs on the hot path: workers enqueue
+ * alerts into an MPMC outbox (full outbox drops, counted) and a dedicated
+ * thread drains it, writing each batch as length-prefixed frames
+ * (4-byte network-order length + payload, the wire format the Python
+ * bridge already speaks) with ONE writev per batch. A broken connection
+ * triggers exponential-backoff reconnect (100ms..5s); the in-flight
+ * batch is retained across reconnects, so a bridge restart costs
+ * buffering, not alert loss, and never stalls the engine.
+ */
+
+#ifndef TCP_SINK_HPP
+#define TCP_SINK_HPP
+
+#include "hft_core.hpp"
+#include "metrics.hpp"
+#include <atomic>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+#ifndef _WIN32
+#include <netinet/tcp.h>
+#include <sys/uio.h>
+#endif
+
+class TcpAlertSink {
+    MpmcRingBuffer<IpcMessage, 4096> outbox;
+    std::thread sender_thread;
+    std::atomic<bool> running{false};
+    std::atomic<uint64_t> sent{0};
+    std::string host;
+    int port = 0;
+    int sock = -1;
+
+    static constexpr size_t DRAIN_BATCH = 16;
+    static constexpr uint64_t BACKOFF_MIN_MS = 100;
+    static constexpr uint64_t BACKOFF_MAX_MS = 5000;
+
+public:
+    ~TcpAlertSink() { stop(); }
+
+    bool start(const std::string& peer_host, int peer_port) {
+#ifdef _WIN32
+        printf("[TCPSINK] Not supported on this platform.\n");
+        (void)peer_host; (void)peer_port;
+        return false;
+#else
+        host = peer_host;
+        port = peer_port;
+        running = true;
+        sender_thread = std::thread(&TcpAlertSink::sender_loop, this);
+        printf("[TCPSINK] Alert feed to %s:%d started.\n", host.c_str(), port);
+        return true;
+#endif
+    }
+
+    // Hot-path hook: non-blocking; inert until start(). A full outbox
+    // drops the alert (counted) rather than stalling the worker.
+    void send(const IpcMessage& msg) {
+        if (!running.load(std::memory_order_relaxed)) return;
+        if (!outbox.push(msg)) Metrics::record_tcp_sink_drop();
+    }
+
+    void stop() {
+        if (!running.exchange(false)) return;
+        if (sender_thread.joinable()) sender_thread.join();
+        printf("[TCPSINK] Feed closed. %llu alerts delivered.\n",
+               (unsigned long long)sent.load());
+    }
+
+private:
+#ifndef _WIN32
+    void sender_loop() {
+        IpcMessage batch[DRAIN_BATCH];
+        size_t staged = 0; // retained across reconnects until written
+        uint64_t backoff_ms = BACKOFF_MIN_MS;
+        bool ever_connected = false;
+
+        while (running.load(std::memory_order_relaxed)) {
+            if (sock < 0) {
+                if (!try_connect()) {
+                    backoff_sleep(backoff_ms);
+                    backoff_ms = backoff_ms * 2 > BACKOFF_MAX_MS ? BACKOFF_MAX_MS
+                                                                 : backoff_ms * 2;
+                    continue;
+                }
+                backoff_ms = BACKOFF_MIN_MS;
+                if (ever_connected) Metrics::record_tcp_sink_reconnect();
+                ever_connected = true;
+            }
+
+            if (staged == 0) {
+                while (staged < DRAIN_BATCH && outbox.pop(batch[staged])) staged++;
+            }
+            if (staged == 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                continue;
+            }
+
+            // Orderly-shutdown probe: a restarting bridge FINs first, and
+            // a write into a FIN'd socket "succeeds" into the void. Peek
+            // catches the FIN so the batch is held for the reconnect.
+            char probe;
+            ssize_t pr = ::recv(sock, &probe, 1, MSG_PEEK | MSG_DONTWAIT);
+            if (pr == 0) {
+                disconnect();
+                continue;
+            }
+
+            if (write_frames(batch, staged)) {
+                sent.fetch_add(staged, std::memory_order_relaxed);
+                staged = 0;
+            } else {
+                // Peer went away mid-write; the batch stays staged and is
+                // re-sent in full after reconnect (frames are atomic from
+                // the bridge's view: it reads length-then-payload).
+                disconnect();
+            }
+        }
+
+        // Shutdown: flush what a live connection can still take.
+        if (sock >= 0) {
+            if (staged > 0 && write_frames(batch, staged)) {
+                sent.fetch_add(staged, std::memory_order_relaxed);
+            }
+            IpcMessage msg;
+            while (outbox.pop(msg)) {
+                if (!write_frames(&msg, 1)) break;
+                sent.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        disconnect();
+    }
+
+    bool try_connect() {
+        sock = ::socket(AF_INET, SOCK_STREAM, 0);
+        if (sock < 0) return false;
+
+        struct sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(port);
+        if (inet_pton(AF_INET, host.c_str(), &addr.sin_addr) <= 0 ||
+            ::connect(sock, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+            disconnect();
+            return false;
+        }
+        int one = 1;
+        setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        return true;
+    }
+
+    void disconnect() {
+        if (sock >= 0) {
+            ::close(sock);
+            sock = -1;
+        }
+    }
+
+    // One writev per batch: [len][payload] pairs for every staged alert.
+    // Handles partial writes by advancing the iovec window; returns false
+    // on a socket error (caller reconnects and re-sends the batch).
+    bool write_frames(IpcMessage* batch, size_t n) {
+        uint32_t lens[DRAIN_BATCH];
+        struct iovec iov[DRAIN_BATCH * 2];
+        size_t total = 0;
+        for (size_t i = 0; i < n; ++i) {
+            lens[i] = htonl((uint32_t)batch[i].len);
+            iov[i * 2] = { &lens[i], sizeof(uint32_t) };
+            iov[i * 2 + 1] = { batch[i].data, batch[i].len };
+            total += sizeof(uint32_t) + batch[i].len;
+        }
+
+        size_t iov_idx = 0;
+        while (total > 0) {
+            struct msghdr mh{};
+            mh.msg_iov = &iov[iov_idx];
+            mh.msg_iovlen = n * 2 - iov_idx;
+            // MSG_NOSIGNAL: a raced peer death must surface as EPIPE for
+            // the reconnect path, not kill the process with SIGPIPE.
+            ssize_t w = ::sendmsg(sock, &mh, MSG_NOSIGNAL);
+            if (w <= 0) return false;
+            total -= (size_t)w;
+
+            // Advance past fully written iovecs, trim the partial one.
+            size_t written = (size_t)w;
+            while (written > 0 && iov_idx < n * 2) {
+                if (written >= iov[iov_idx].iov_len) {
+                    written -= iov[iov_idx].iov_len;
+                    iov_idx++;
+                } else {
+                    iov[iov_idx].iov_base = (char*)iov[iov_idx].iov_base + written;
+                    iov[iov_idx].iov_len -= written;
+                    written = 0;
+                }
+            }
+        }
+        return true;
+    }
+
+    void backoff_sleep(uint64_t ms) {
+        // Sliced so stop() is honored within ~100ms even at max backoff.
+        for (uint64_t slept = 0;
+             slept < ms && running.load(std::memory_order_relaxed); slept += 100) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+    }
+#endif
+};
+
+#endif
@@ -1,44 +1,165 @@
 /*
  * Project Aegis - Telemetry
  * High-performance non-blocking tracing (UDP).
+ *
+ * Binary span records are staged in a lock-free MPMC ring by the worker
+ * threads and drained by a dedicated sender thread over a connected UDP
+ * socket. The hot path never issues a syscall; under backpressure spans
+ * are dropped and counted, never blocked on.
  */
 
 #ifndef TELEMETRY_HPP
 #define TELEMETRY_HPP
 
+#include "hft_core.hpp"
 #include <string>
 #include <iostream>
 #include <chrono>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+#ifdef _WIN32
+    #include <winsock2.h>
+    #include <ws2tcpip.h>
+    #pragma comment(lib, "Ws2_32.lib")
+#else
+    #include <sys/socket.h>
+    #include <netinet/in.h>
+    #include <arpa/inet.h>
+    #include <unistd.h>
+#endif
 
 class Telemetry {
 public:
-    static void init(const std::string& host, int port) {
-        std::cout << "[TELEMETRY] Initialized UDP Sink -> " << host << ":" << port << std::endl;
-    }
+    // Fixed-size wire record. Sent as raw little-endian structs, packed
+    // multiple records per datagram; the collector shares this layout.
+    struct SpanRecord {
+        uint64_t trace_id;
+        uint64_t op_id;       // FNV1a of the operation name
+        uint64_t start_ns;
+        uint64_t duration_ns;
+        float    risk_score;
+        uint8_t  blocked;
+        uint8_t  pad[3];
+    };
+    static_assert(sizeof(SpanRecord) == 40, "SpanRecord layout is wire format");
 
     struct Span {
-        const char* operation;
-        uint64_t trace_id; // Simple ID
+        uint64_t op_id;
+        uint64_t trace_id;
         long start_ns;
     };
 
+    static void init(const std::string& host, int port) {
+#ifdef _WIN32
+        WSADATA wsaData;
+        WSAStartup(MAKEWORD(2, 2), &wsaData);
+#endif
+        sock_fd = (int)socket(AF_INET, SOCK_DGRAM, 0);
+        if (sock_fd < 0) {
+            std::cout << "[TELEMETRY] UDP socket creation failed. Tracing disabled." << std::endl;
+            return;
+        }
+
+        struct sockaddr_in addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(port);
+        if (inet_pton(AF_INET, host.c_str(), &addr.sin_addr) <= 0 ||
+            ::connect(sock_fd, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+            std::cout << "[TELEMETRY] UDP sink unreachable. Tracing disabled." << std::endl;
+            close_socket();
+            return;
+        }
+
+        running.store(true);
+        sender_thread = std::thread(&Telemetry::sender_loop);
+        std::cout << "[TELEMETRY] Initialized UDP Sink -> " << host << ":" << port << std::endl;
+    }
+
+    static void shutdown() {
+        running.store(false);
+        if (sender_thread.joinable()) sender_thread.join();
+        close_socket();
+    }
+
     static Span start_span(const char* name) {
         long now = std::chrono::steady_clock::now().time_since_epoch().count();
-        return { name, 0, now };
+        return { fnv1a_hash(name, strlen(name)),
+                 next_trace_id.fetch_add(1, std::memory_order_relaxed),
+                 now };
     }
 
     static void end_span(const Span& span, float risk_score, bool blocked) {
         long end = std::chrono::steady_clock::now().time_since_epoch().count();
-        long duration = end - span.start_ns;
 
-        // Emitting UDP Packet... (Mocked)
-        // Format: TraceID | Op | Duration | Tags
+        SpanRecord rec;
+        rec.trace_id = span.trace_id;
+        rec.op_id = span.op_id;
+        rec.start_ns = (uint64_t)span.start_ns;
+        rec.duration_ns = (uint64_t)(end - span.start_ns);
+        rec.risk_score = risk_score;
+        rec.blocked = blocked ? 1 : 0;
+        rec.pad[0] = rec.pad[1] = rec.pad[2] = 0;
+
+        // MPMC ring: any worker may emit concurrently.
+        // Drop-don't-block under backpressure.
+        if (!span_ring.push(rec)) {
+            dropped_spans.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // Spans lost to ring backpressure since startup (for metrics export).
+    static uint64_t dropped() {
+        return dropped_spans.load(std::memory_order_relaxed);
+    }
+
+private:
+    static inline MpmcRingBuffer<SpanRecord, 8192> span_ring;
+    static inline std::thread sender_thread;
+    static inline std::atomic<bool> running{false};
+    static inline std::atomic<uint64_t> next_trace_id{1};
+    static inline std::atomic<uint64_t> dropped_spans{0};
+    static inline int sock_fd = -1;
+
+    static void close_socket() {
+        if (sock_fd >= 0) {
+#ifdef _WIN32
+            closesocket(sock_fd);
+            WSACleanup();
+#else
+            ::close(sock_fd);
+#endif
+            sock_fd = -1;
+        }
+    }
+
+    static void sender_loop() {
+        // ~1.2KB per datagram: safely under a 1500-byte MTU.
+        constexpr size_t RECORDS_PER_PACKET = 30;
+        SpanRecord batch[RECORDS_PER_PACKET];
 
-        // In HFT, we don't print! We send binary struct to socket.
-        // For visual demo, we print only anomalous/high-latency events.
-        if (duration > 5000) { // > 5us
-             // printf("[SLOW] %s took %ld ns\n", span.operation, duration);
+        while (running.load(std::memory_order_relaxed)) {
+            size_t n = drain(batch, RECORDS_PER_PACKET);
+            if (n == 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                continue;
+            }
+            ::send(sock_fd, (const char*)batch, (int)(n * sizeof(SpanRecord)), 0);
         }
+
+        // Final drain so a clean shutdown flushes buffered spans.
+        size_t n;
+        while ((n = drain(batch, RECORDS_PER_PACKET)) > 0) {
+            ::send(sock_fd, (const char*)batch, (int)(n * sizeof(SpanRecord)), 0);
+        }
+    }
+
+    static size_t drain(SpanRecord* out, size_t max) {
+        size_t n = 0;
+        while (n < max && span_ring.pop(out[n])) ++n;
+        return n;
     }
 };
 
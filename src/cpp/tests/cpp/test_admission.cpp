@@ -0,0 +1,114 @@
+/*
+ * Project Aegis - Unit Tests (Admission Control)
+ * Lane classification and the low-lane shed / high-lane reserve policy.
+ */
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "../../admission.hpp"
+
+namespace {
+
+PaymentData make_payment(const char* debtor, int64_t amount, const char* ccy = "EUR") {
+    PaymentData pmt{};
+    snprintf(pmt.debtor_name, sizeof(pmt.debtor_name), "%s", debtor);
+    snprintf(pmt.creditor_name, sizeof(pmt.creditor_name), "%s", "Beneficiary Corp");
+    snprintf(pmt.currency, sizeof(pmt.currency), "%s", ccy);
+    snprintf(pmt.uetr, sizeof(pmt.uetr), "%s", "550e8400-e29b-41d4-a716-446655440000");
+    pmt.amount = amount;
+    pmt.valid_schema = true;
+    return pmt;
+}
+
+// Single-worker harness; rings are ~3MB each so they live on the heap.
+struct Harness {
+    std::unique_ptr<PaymentRingBuffer> ring{new PaymentRingBuffer()};
+    PaymentRouter router{ring.get(), 1};
+};
+
+constexpr int64_t kThreshold = 10000LL * 1000000LL; // 10,000.00 units
+constexpr size_t kReserve = PaymentRingBuffer::capacity() / 8;
+
+} // namespace
+
+// =============================================================================
+// Lane Classification
+// =============================================================================
+
+TEST(AdmissionControlTest, ClassifiesByAmountThreshold) {
+    Harness h;
+    AdmissionController adm(h.router, kThreshold);
+
+    EXPECT_EQ(adm.classify(make_payment("Small", kThreshold - 1)), Lane::Low);
+    EXPECT_EQ(adm.classify(make_payment("AtThreshold", kThreshold)), Lane::High);
+    EXPECT_EQ(adm.classify(make_payment("Large", kThreshold * 10)), Lane::High);
+}
+
+TEST(AdmissionControlTest, FlaggedCurrencyRoutesHigh) {
+    Harness h;
+    AdmissionController adm(h.router, kThreshold, "USD,GBP");
+
+    EXPECT_EQ(adm.classify(make_payment("SmallEur", 100, "EUR")), Lane::Low);
+    EXPECT_EQ(adm.classify(make_payment("SmallUsd", 100, "USD")), Lane::High);
+    EXPECT_EQ(adm.classify(make_payment("SmallGbp", 100, "GBP")), Lane::High);
+}
+
+// =============================================================================
+// Shed Policy & High-Lane Reserve
+// =============================================================================
+
+TEST(AdmissionControlTest, LowLaneAdmitsWhileRingHasHeadroom) {
+    Harness h;
+    AdmissionController adm(h.router, kThreshold);
+
+    EXPECT_TRUE(adm.submit(make_payment("Small", 100)));
+    EXPECT_EQ(h.ring->size_approx(), 1u);
+}
+
+TEST(AdmissionControlTest, LowLaneShedsAtReserveWatermark) {
+    Harness h;
+    AdmissionController adm(h.router, kThreshold);
+
+    // Saturate the low lane; admission must stop at capacity - reserve.
+    PaymentData low = make_payment("Small", 100);
+    size_t admitted = 0;
+    while (adm.submit(low)) admitted++;
+
+    EXPECT_EQ(admitted, PaymentRingBuffer::capacity() - kReserve);
+    EXPECT_EQ(h.ring->size_approx(), admitted);
+
+    // Once shedding starts, further low-lane traffic is refused without
+    // blocking...
+    EXPECT_FALSE(adm.submit(low));
+
+    // ...while the high lane still lands in the reserved headroom.
+    PaymentData high = make_payment("Regulated", kThreshold * 2);
+    EXPECT_TRUE(adm.submit(high));
+    EXPECT_EQ(h.ring->size_approx(), admitted + 1);
+}
+
+TEST(AdmissionControlTest, BatchLowSubmitReportsAdmittedCount) {
+    Harness h;
+    AdmissionController adm(h.router, kThreshold);
+
+    std::vector<PaymentData> batch(64, make_payment("Small", 100));
+    EXPECT_EQ(adm.submit_low(0, std::span<const PaymentData>(batch)), batch.size());
+
+    // Drain and refill to just under the watermark; a batch straddling it
+    // is split: the headroom is admitted, the surplus shed.
+    PaymentData sink;
+    while (h.ring->pop(sink)) {}
+    size_t budget = PaymentRingBuffer::capacity() - kReserve;
+    std::vector<PaymentData> fill(budget - 10, make_payment("Small", 100));
+    size_t pre = 0;
+    for (size_t off = 0; off < fill.size(); ) {
+        size_t n = adm.submit_low(0, std::span<const PaymentData>(fill).subspan(off));
+        ASSERT_GT(n, 0u);
+        off += n;
+        pre += n;
+    }
+    EXPECT_EQ(adm.submit_low(0, std::span<const PaymentData>(batch)), 10u);
+}
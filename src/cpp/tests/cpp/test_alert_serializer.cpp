@@ -0,0 +1,106 @@
+/**
+ * Project Aegis - Alert Serializer Unit Tests
+ *
+ * Verifies the fixed-layout alert JSON serializer stays byte-identical
+ * to the snprintf formatting it replaced on the hot path.
+ */
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "../../hft_core.hpp"
+
+namespace {
+
+PaymentData make_payment(const char* debtor, int64_t amount_micros, const char* uetr) {
+    PaymentData pmt{};
+    strncpy(pmt.debtor_name, debtor, sizeof(pmt.debtor_name) - 1);
+    strncpy(pmt.uetr, uetr, sizeof(pmt.uetr) - 1);
+    pmt.amount = amount_micros;
+    pmt.valid_schema = true;
+    return pmt;
+}
+
+// The layout the serializer must reproduce, bit for bit.
+std::string reference_format(const PaymentData& pmt) {
+    char buf[512];
+    int len = snprintf(buf, sizeof(buf),
+        "{ \"debtor\": \"%s\", \"amount\": %lld.%06lld, \"uetr\": \"%s\" }",
+        pmt.debtor_name, (long long)(pmt.amount / 1000000),
+        (long long)(std::abs(pmt.amount % 1000000)), pmt.uetr);
+    return std::string(buf, (size_t)len);
+}
+
+} // namespace
+
+TEST(AlertSerializerTest, MatchesReferenceLayout) {
+    PaymentData pmt = make_payment("Alice Smith", 1000500000,
+                                   "550e8400-e29b-41d4-a716-446655440000");
+    IpcMessage msg;
+    AlertSerializer::serialize(pmt, msg);
+
+    EXPECT_EQ(std::string(msg.data, msg.len), reference_format(pmt));
+}
+
+TEST(AlertSerializerTest, AmountFractionIsZeroPaddedToSixDigits) {
+    PaymentData pmt = make_payment("Bob", 5000042, "uetr-1");
+    IpcMessage msg;
+    AlertSerializer::serialize(pmt, msg);
+
+    std::string out(msg.data, msg.len);
+    EXPECT_NE(out.find("\"amount\": 5.000042"), std::string::npos);
+    EXPECT_EQ(out, reference_format(pmt));
+}
+
+TEST(AlertSerializerTest, WholeUnitsOnly) {
+    PaymentData pmt = make_payment("Carol", 7000000, "uetr-2");
+    IpcMessage msg;
+    AlertSerializer::serialize(pmt, msg);
+
+    std::string out(msg.data, msg.len);
+    EXPECT_NE(out.find("\"amount\": 7.000000"), std::string::npos);
+    EXPECT_EQ(out, reference_format(pmt));
+}
+
+TEST(AlertSerializerTest, SubUnitAmount) {
+    PaymentData pmt = make_payment("Dave", 500, "uetr-3");
+    IpcMessage msg;
+    AlertSerializer::serialize(pmt, msg);
+
+    std::string out(msg.data, msg.len);
+    EXPECT_NE(out.find("\"amount\": 0.000500"), std::string::npos);
+    EXPECT_EQ(out, reference_format(pmt));
+}
+
+TEST(AlertSerializerTest, LargeAmount) {
+    // Near the top of the representable range: 9.2 trillion units.
+    PaymentData pmt = make_payment("Eve", 9223372036854775807LL, "uetr-4");
+    IpcMessage msg;
+    AlertSerializer::serialize(pmt, msg);
+
+    EXPECT_EQ(std::string(msg.data, msg.len), reference_format(pmt));
+}
+
+TEST(AlertSerializerTest, MaxLengthFieldsFitInMessage) {
+    // 63-char debtor name and 36-char UETR: the worst case layout.
+    std::string long_name(63, 'N');
+    std::string long_uetr(36, 'u');
+    PaymentData pmt = make_payment(long_name.c_str(), 123456789012345LL, long_uetr.c_str());
+
+    IpcMessage msg;
+    AlertSerializer::serialize(pmt, msg);
+
+    EXPECT_LT(msg.len, sizeof(msg.data));
+    EXPECT_EQ(msg.data[msg.len], '\0');
+    EXPECT_EQ(std::string(msg.data, msg.len), reference_format(pmt));
+}
+
+TEST(AlertSerializerTest, OutputIsNulTerminated) {
+    PaymentData pmt = make_payment("Frank", 1, "uetr-5");
+    IpcMessage msg;
+    memset(msg.data, 'X', sizeof(msg.data));
+    AlertSerializer::serialize(pmt, msg);
+
+    EXPECT_EQ(strlen(msg.data), msg.len);
+}
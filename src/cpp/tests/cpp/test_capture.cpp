@@ -0,0 +1,131 @@
+/*
+ * Project Aegis - Unit Tests (Binary Capture Journal)
+ * Round-trips PaymentData records through CaptureWriter and validates the
+ * on-disk format guards (header magic, record-size pinning, append mode).
+ */
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "../../capture.hpp"
+
+namespace {
+
+std::string temp_capture_path(const char* tag) {
+    char buf[128];
+    snprintf(buf, sizeof(buf), "/tmp/aegis_capture_%s_%d.bin", tag, (int)getpid());
+    return buf;
+}
+
+PaymentData make_payment(int seq) {
+    PaymentData pmt{};
+    snprintf(pmt.debtor_name, sizeof(pmt.debtor_name), "Debtor-%d", seq);
+    snprintf(pmt.creditor_name, sizeof(pmt.creditor_name), "Creditor-%d", seq);
+    memcpy(pmt.currency, "EUR", 4);
+    snprintf(pmt.uetr, sizeof(pmt.uetr), "550e8400-e29b-41d4-a716-4466554%05d", seq);
+    pmt.amount = 1000000LL * seq;
+    pmt.valid_schema = true;
+    pmt.ingress_ticks = (uint64_t)seq;
+    return pmt;
+}
+
+std::vector<char> read_file(const std::string& path) {
+    std::ifstream is(path, std::ios::binary);
+    return std::vector<char>((std::istreambuf_iterator<char>(is)),
+                             std::istreambuf_iterator<char>());
+}
+
+// Drains the writer's queue deterministically: stop() joins the background
+// thread after a final flush, so everything record()'d is on disk.
+void write_session(const std::string& path, int first, int count) {
+    CaptureWriter writer;
+    ASSERT_TRUE(writer.start(path));
+    for (int i = 0; i < count; ++i) writer.record(make_payment(first + i));
+    writer.stop();
+    EXPECT_EQ(writer.records_written(), (uint64_t)count);
+    EXPECT_EQ(writer.records_dropped(), 0u);
+}
+
+} // namespace
+
+// =============================================================================
+// CaptureWriter Round-Trip
+// =============================================================================
+
+TEST(CaptureJournalTest, RoundTripPreservesRecords) {
+    const std::string path = temp_capture_path("roundtrip");
+    unlink(path.c_str());
+
+    constexpr int kRecords = 300;
+    write_session(path, 0, kRecords);
+
+    std::vector<char> bytes = read_file(path);
+    ASSERT_EQ(bytes.size(), sizeof(CaptureHeader) + kRecords * sizeof(PaymentData));
+    ASSERT_TRUE(is_capture_buffer(bytes.data(), bytes.size()));
+
+    for (int i = 0; i < kRecords; ++i) {
+        PaymentData rec;
+        memcpy(&rec, bytes.data() + sizeof(CaptureHeader) + i * sizeof(PaymentData),
+               sizeof(PaymentData));
+        PaymentData expect = make_payment(i);
+        EXPECT_STREQ(rec.debtor_name, expect.debtor_name);
+        EXPECT_STREQ(rec.uetr, expect.uetr);
+        EXPECT_EQ(rec.amount, expect.amount);
+        EXPECT_TRUE(rec.valid_schema);
+    }
+    unlink(path.c_str());
+}
+
+TEST(CaptureJournalTest, AppendsAcrossSessions) {
+    const std::string path = temp_capture_path("append");
+    unlink(path.c_str());
+
+    write_session(path, 0, 100);
+    write_session(path, 100, 50); // reopen appends, header written once
+
+    std::vector<char> bytes = read_file(path);
+    ASSERT_EQ(bytes.size(), sizeof(CaptureHeader) + 150 * sizeof(PaymentData));
+
+    PaymentData last;
+    memcpy(&last, bytes.data() + bytes.size() - sizeof(PaymentData), sizeof(PaymentData));
+    EXPECT_STREQ(last.debtor_name, "Debtor-149");
+    unlink(path.c_str());
+}
+
+// =============================================================================
+// Format Guards
+// =============================================================================
+
+TEST(CaptureJournalTest, RejectsNonCaptureBuffer) {
+    const char* xml = "<?xml version=\"1.0\"?><Document></Document>\n";
+    EXPECT_FALSE(is_capture_buffer(xml, strlen(xml)));
+    EXPECT_FALSE(is_capture_buffer(xml, 3)); // shorter than a header
+}
+
+TEST(CaptureJournalTest, RejectsWrongRecordSize) {
+    CaptureHeader hdr{};
+    memcpy(hdr.magic, CAPTURE_MAGIC, 4);
+    hdr.version = CAPTURE_VERSION;
+    hdr.record_size = (uint16_t)(sizeof(PaymentData) - 8); // stale layout
+    EXPECT_FALSE(is_capture_buffer(&hdr, sizeof(hdr)));
+
+    hdr.record_size = (uint16_t)sizeof(PaymentData);
+    EXPECT_TRUE(is_capture_buffer(&hdr, sizeof(hdr)));
+}
+
+TEST(CaptureJournalTest, RefusesAppendToForeignFile) {
+    const std::string path = temp_capture_path("foreign");
+    {
+        std::ofstream os(path, std::ios::binary);
+        os << "not a capture file";
+    }
+    CaptureWriter writer;
+    EXPECT_FALSE(writer.start(path));
+    unlink(path.c_str());
+}
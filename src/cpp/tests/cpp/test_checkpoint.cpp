@@ -0,0 +1,110 @@
+/*
+ * Project Aegis - Unit Tests (Risk-State Checkpoint)
+ * Snapshot/restore round-trip, cold-start behavior and layout pinning.
+ */
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <unistd.h>
+
+#include "../../checkpoint.hpp"
+
+namespace {
+
+std::string temp_snapshot_path() {
+    char tmpl[] = "/tmp/aegis_ckpt_XXXXXX";
+    int fd = mkstemp(tmpl);
+    if (fd >= 0) ::close(fd);
+    return std::string(tmpl);
+}
+
+// Looks up an entity's live state directly in its shard map.
+EntityState* find_state(FastRiskEngine& engine, const char* name) {
+    size_t len = strlen(name);
+    uint64_t h = FastRiskEngine::fnv1a_hash(name, len);
+    return engine.shards[h & (RISK_MAP_SHARDS - 1)].map.find(h, name, len);
+}
+
+} // namespace
+
+TEST(RiskCheckpointTest, SnapshotRestoreRoundTrip) {
+    std::string path = temp_snapshot_path();
+
+    // Engines are ~MB-scale (1024 shard tables); keep them off the stack.
+    auto source = std::make_unique<FastRiskEngine>();
+    for (int i = 0; i < 5; ++i) {
+        source->evaluate("Repeat Offender GmbH", strlen("Repeat Offender GmbH"), 9500LL * 1000000LL);
+    }
+    EntityState* before = find_state(*source, "Repeat Offender GmbH");
+    ASSERT_NE(before, nullptr);
+    float velocity_before = before->velocity_accumulator.load();
+    float structuring_before = before->structuring_score.load();
+    ASSERT_GT(velocity_before, 0.0f);
+
+    RiskCheckpoint writer(*source);
+    ASSERT_TRUE(writer.write_snapshot(path));
+
+    auto restored = std::make_unique<FastRiskEngine>();
+    RiskCheckpoint reader(*restored);
+    ASSERT_TRUE(reader.restore(path));
+
+    EntityState* after = find_state(*restored, "Repeat Offender GmbH");
+    ASSERT_NE(after, nullptr);
+    EXPECT_FLOAT_EQ(after->velocity_accumulator.load(), velocity_before);
+    EXPECT_FLOAT_EQ(after->structuring_score.load(), structuring_before);
+    EXPECT_EQ(after->last_seen_timestamp.load(), before->last_seen_timestamp.load());
+
+    ::unlink(path.c_str());
+}
+
+TEST(RiskCheckpointTest, MissingSnapshotIsCleanColdStart) {
+    auto engine = std::make_unique<FastRiskEngine>();
+    RiskCheckpoint ckpt(*engine);
+    EXPECT_FALSE(ckpt.restore("/tmp/aegis_ckpt_does_not_exist"));
+}
+
+TEST(RiskCheckpointTest, WrongLayoutIsRefused) {
+    std::string path = temp_snapshot_path();
+    FILE* f = fopen(path.c_str(), "wb");
+    ASSERT_NE(f, nullptr);
+    CheckpointHeader hdr{};
+    memcpy(hdr.magic, CHECKPOINT_MAGIC, 4);
+    hdr.version = CHECKPOINT_VERSION;
+    hdr.record_size = (uint16_t)(sizeof(CheckpointRecord) + 8); // layout drift
+    fwrite(&hdr, sizeof(hdr), 1, f);
+    fclose(f);
+
+    auto engine = std::make_unique<FastRiskEngine>();
+    RiskCheckpoint ckpt(*engine);
+    EXPECT_FALSE(ckpt.restore(path));
+
+    ::unlink(path.c_str());
+}
+
+TEST(RiskCheckpointTest, SnapshotReplacesFileAtomically) {
+    std::string path = temp_snapshot_path();
+
+    auto engine = std::make_unique<FastRiskEngine>();
+    engine->evaluate("Entity A", strlen("Entity A"), 100);
+
+    RiskCheckpoint ckpt(*engine);
+    ASSERT_TRUE(ckpt.write_snapshot(path));
+    ASSERT_TRUE(ckpt.write_snapshot(path)); // second pass renames over the first
+
+    // No staging file left behind; the snapshot itself is valid.
+    EXPECT_NE(::access((path + ".tmp").c_str(), F_OK), 0);
+    auto restored = std::make_unique<FastRiskEngine>();
+    RiskCheckpoint reader(*restored);
+    EXPECT_TRUE(reader.restore(path));
+    EXPECT_NE(find_state(*restored, "Entity A"), nullptr);
+
+    ::unlink(path.c_str());
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -275,6 +275,73 @@ TEST_F(IsoParserTest, HandleMinimalValidPayment) {
     EXPECT_EQ(payment.amount, 10000); // 0.01 * 10^6
 }
 
+// =============================================================================
+// Policy Specialization Tests
+// =============================================================================
+
+#ifndef AEGIS_USE_PUGIXML_PARSER
+
+namespace {
+
+const char* kPain001Eur = R"(<?xml version="1.0"?>
+<Document>
+  <CstmrCdtTrfinitn>
+    <PmtInf>
+      <PmtId><UETR>policy-test-uetr</UETR></PmtId>
+      <Dbtr><Nm>Policy Debtor</Nm></Dbtr>
+      <Cdtr><Nm>Policy Creditor</Nm></Cdtr>
+      <Amt><InstdAmt Ccy="EUR">100.00</InstdAmt></Amt>
+    </PmtInf>
+  </CstmrCdtTrfinitn>
+</Document>)";
+
+const char* kPacs008Usd = R"(<?xml version="1.0"?>
+<Document>
+  <FIToFICdtTrf>
+    <CdtTrfTxInf>
+      <PmtId><EndToEndId>policy-e2e-id</EndToEndId></PmtId>
+      <Dbtr><Nm>Interbank Debtor</Nm></Dbtr>
+      <Cdtr><Nm>Interbank Creditor</Nm></Cdtr>
+      <Amt><InstdAmt Ccy="USD">100.00</InstdAmt></Amt>
+    </CdtTrfTxInf>
+  </FIToFICdtTrf>
+</Document>)";
+
+} // namespace
+
+TEST_F(IsoParserTest, Pain001PolicyRejectsPacsEnvelope) {
+    EXPECT_TRUE(BasicIsoParser<Pain001Policy>::parse(
+        kPain001Eur, strlen(kPain001Eur), payment));
+    EXPECT_FALSE(BasicIsoParser<Pain001Policy>::parse(
+        kPacs008Usd, strlen(kPacs008Usd), payment));
+}
+
+TEST_F(IsoParserTest, Pacs008PolicyRejectsPainEnvelope) {
+    EXPECT_TRUE(BasicIsoParser<Pacs008Policy>::parse(
+        kPacs008Usd, strlen(kPacs008Usd), payment));
+    EXPECT_FALSE(BasicIsoParser<Pacs008Policy>::parse(
+        kPain001Eur, strlen(kPain001Eur), payment));
+}
+
+TEST_F(IsoParserTest, EurOnlyPolicyNarrowsCurrencyWhitelist) {
+    EXPECT_TRUE(BasicIsoParser<Pain001EurPolicy>::parse(
+        kPain001Eur, strlen(kPain001Eur), payment));
+    EXPECT_FALSE(BasicIsoParser<Pacs008EurPolicy>::parse(
+        kPacs008Usd, strlen(kPacs008Usd), payment));
+}
+
+TEST_F(IsoParserTest, GenericPolicyMatchesSpecializedResults) {
+    PaymentData generic{}, specialized{};
+    ASSERT_TRUE(IsoParser::parse(kPain001Eur, strlen(kPain001Eur), generic));
+    ASSERT_TRUE(BasicIsoParser<Pain001EurPolicy>::parse(
+        kPain001Eur, strlen(kPain001Eur), specialized));
+    EXPECT_STREQ(generic.uetr, specialized.uetr);
+    EXPECT_STREQ(generic.debtor_name, specialized.debtor_name);
+    EXPECT_EQ(generic.amount, specialized.amount);
+}
+
+#endif // AEGIS_USE_PUGIXML_PARSER
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -0,0 +1,67 @@
+/*
+ * Project Aegis - Unit Tests (Pipeline Stats)
+ * Stage cycle accumulation, ring high-water marks, shard-lock wait totals
+ * and the /debug/stats JSON export.
+ */
+
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+
+#include "../../metrics.hpp"
+
+// Counters are namespace-level statics, so tests in this translation unit
+// share one set; each test uses its own stage/slot to stay independent.
+
+TEST(PipelineStatsTest, StageCyclesAccumulate) {
+    Metrics::record_stage_cycles(Metrics::STAGE_PARSE, 100);
+    Metrics::record_stage_cycles(Metrics::STAGE_PARSE, 300, 2);
+
+    std::string json = Metrics::export_debug_json();
+    EXPECT_NE(json.find("\"parse\": {\"events\": 3, \"cycles_total\": 400"),
+              std::string::npos) << json;
+}
+
+TEST(PipelineStatsTest, RingHighWaterMarkIsMonotonic) {
+    Metrics::record_ring_occupancy(2, 1000, 16383);
+    Metrics::record_ring_occupancy(2, 40, 16383);
+
+    // Depth tracks the latest sample; the high-water mark keeps the peak.
+    EXPECT_EQ(Metrics::g_ring_depth[2].load(), 40u);
+    EXPECT_EQ(Metrics::g_ring_hwm[2].load(), 1000u);
+
+    // The legacy usage gauge is now fed from the deepest ring.
+    EXPECT_GT(Metrics::g_ring_buffer_usage.load(), 0.0);
+
+    // Out-of-range worker ids are ignored, not UB.
+    Metrics::record_ring_occupancy(Metrics::MAX_TRACKED_RINGS, 1, 16383);
+}
+
+TEST(PipelineStatsTest, ShardLockWaitAccumulates) {
+    uint64_t before = Metrics::g_shard_lock_acquisitions.load();
+    Metrics::record_shard_lock_wait(50);
+    Metrics::record_shard_lock_wait(70);
+    EXPECT_EQ(Metrics::g_shard_lock_acquisitions.load(), before + 2);
+    EXPECT_GE(Metrics::g_shard_lock_wait_cycles.load(), 120u);
+
+    std::string json = Metrics::export_debug_json();
+    EXPECT_NE(json.find("\"shard_locks\""), std::string::npos);
+}
+
+TEST(PipelineStatsTest, DebugJsonUsesShardProvider) {
+    // Before registration the shards section is explicit null.
+    EXPECT_NE(Metrics::export_debug_json().find("\"shards\": null"),
+              std::string::npos);
+
+    Metrics::set_shard_stats_provider(+[](std::ostringstream& out) {
+        out << "{\"entries_total\": 42}";
+    });
+    std::string json = Metrics::export_debug_json();
+    EXPECT_NE(json.find("\"shards\": {\"entries_total\": 42}"),
+              std::string::npos) << json;
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -104,7 +104,7 @@ TEST_F(RingBufferTest, WrapAround) {
 TEST(RingBufferPaymentTest, PaymentDataPushPop) {
     LockFreeRingBuffer<PaymentData, 16> payment_buffer;
 
-    PaymentData payment;
+    PaymentData payment{}; // zero-init: strncpy below doesn't NUL-terminate currency
     strncpy(payment.debtor_name, "Alice", 63);
     strncpy(payment.creditor_name, "Bob", 63);
     strncpy(payment.currency, "EUR", 3);
@@ -124,6 +124,107 @@ TEST(RingBufferPaymentTest, PaymentDataPushPop) {
     EXPECT_TRUE(result.valid_schema);
 }
 
+// =============================================================================
+// Batch API Tests
+// =============================================================================
+
+TEST_F(RingBufferTest, BatchPushAndPop) {
+    int in[5] = {10, 20, 30, 40, 50};
+    EXPECT_EQ(small_buffer.push_batch(std::span<const int>(in)), 5u);
+
+    int out[5] = {0};
+    EXPECT_EQ(small_buffer.pop_batch(std::span<int>(out)), 5u);
+
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_EQ(out[i], in[i]);
+    }
+}
+
+TEST_F(RingBufferTest, BatchPushPartialWhenNearlyFull) {
+    // Capacity is 7 (size 8 minus sentinel); a batch of 10 must truncate.
+    int in[10];
+    for (int i = 0; i < 10; ++i) in[i] = i;
+
+    EXPECT_EQ(small_buffer.push_batch(std::span<const int>(in)), 7u);
+    EXPECT_TRUE(small_buffer.is_full());
+
+    // Items beyond capacity were not enqueued.
+    int out[10];
+    EXPECT_EQ(small_buffer.pop_batch(std::span<int>(out)), 7u);
+    for (int i = 0; i < 7; ++i) {
+        EXPECT_EQ(out[i], i);
+    }
+}
+
+TEST_F(RingBufferTest, BatchPopFromEmptyReturnsZero) {
+    int out[4];
+    EXPECT_EQ(small_buffer.pop_batch(std::span<int>(out)), 0u);
+}
+
+TEST_F(RingBufferTest, BatchWrapAroundPreservesOrder) {
+    // Advance indices so the next batch straddles the wrap point.
+    for (int i = 0; i < 5; ++i) {
+        small_buffer.push(i);
+    }
+    int scratch;
+    for (int i = 0; i < 5; ++i) {
+        small_buffer.pop(scratch);
+    }
+
+    int in[6] = {100, 101, 102, 103, 104, 105};
+    EXPECT_EQ(small_buffer.push_batch(std::span<const int>(in)), 6u);
+
+    int out[6] = {0};
+    EXPECT_EQ(small_buffer.pop_batch(std::span<int>(out)), 6u);
+    for (int i = 0; i < 6; ++i) {
+        EXPECT_EQ(out[i], in[i]) << "Batch wrap-around ordering violated at " << i;
+    }
+}
+
+TEST_F(RingBufferTest, BatchSingleProducerSingleConsumer) {
+    const int NUM_ITEMS = 100000;
+    const int BATCH = 64;
+    std::atomic<long long> consumed_sum{0};
+
+    std::thread producer([&]() {
+        int next = 1;
+        int batch[BATCH];
+        while (next <= NUM_ITEMS) {
+            int n = 0;
+            while (n < BATCH && next + n <= NUM_ITEMS) {
+                batch[n] = next + n;
+                ++n;
+            }
+            size_t pushed = 0;
+            while (pushed < (size_t)n) {
+                pushed += large_buffer.push_batch(
+                    std::span<const int>(batch + pushed, n - pushed));
+                if (pushed < (size_t)n) std::this_thread::yield();
+            }
+            next += n;
+        }
+    });
+
+    std::thread consumer([&]() {
+        int batch[BATCH];
+        long long count = 0;
+        long long sum = 0;
+        while (count < NUM_ITEMS) {
+            size_t n = large_buffer.pop_batch(std::span<int>(batch));
+            for (size_t i = 0; i < n; ++i) sum += batch[i];
+            count += n;
+            if (n == 0) std::this_thread::yield();
+        }
+        consumed_sum = sum;
+    });
+
+    producer.join();
+    consumer.join();
+
+    long long expected = (long long)NUM_ITEMS * (NUM_ITEMS + 1) / 2;
+    EXPECT_EQ(consumed_sum.load(), expected);
+}
+
 // =============================================================================
 // Concurrent Access Tests
 // =============================================================================
@@ -196,6 +297,143 @@ TEST_F(RingBufferTest, StressTestHighThroughput) {
     EXPECT_EQ(items_consumed.load(), NUM_ITEMS);
 }
 
+// =============================================================================
+// MPMC Ring Buffer Tests (Vyukov bounded queue)
+// =============================================================================
+
+TEST(MpmcRingBufferTest, BasicPushAndPop) {
+    MpmcRingBuffer<int, 8> buffer;
+
+    int value = 42;
+    EXPECT_TRUE(buffer.push(value));
+
+    int result = 0;
+    EXPECT_TRUE(buffer.pop(result));
+    EXPECT_EQ(result, 42);
+}
+
+TEST(MpmcRingBufferTest, PopFromEmptyFails) {
+    MpmcRingBuffer<int, 8> buffer;
+    int result;
+    EXPECT_FALSE(buffer.pop(result));
+}
+
+TEST(MpmcRingBufferTest, PushToFullFails) {
+    MpmcRingBuffer<int, 8> buffer;
+
+    // Unlike the SPSC ring, all Size slots are usable.
+    for (int i = 0; i < 8; ++i) {
+        int value = i;
+        EXPECT_TRUE(buffer.push(value));
+    }
+    int extra = 99;
+    EXPECT_FALSE(buffer.push(extra));
+
+    int result;
+    EXPECT_TRUE(buffer.pop(result));
+    EXPECT_EQ(result, 0);
+    EXPECT_TRUE(buffer.push(extra));
+}
+
+TEST(MpmcRingBufferTest, FifoOrderSingleThreaded) {
+    MpmcRingBuffer<int, 64> buffer;
+
+    for (int i = 0; i < 50; ++i) {
+        int value = i;
+        ASSERT_TRUE(buffer.push(value));
+    }
+    for (int i = 0; i < 50; ++i) {
+        int result;
+        ASSERT_TRUE(buffer.pop(result));
+        EXPECT_EQ(result, i);
+    }
+}
+
+TEST(MpmcRingBufferTest, MultipleProducersSingleConsumer) {
+    static MpmcRingBuffer<int, 1024> buffer;
+
+    constexpr int NUM_PRODUCERS = 4;
+    constexpr int ITEMS_PER_PRODUCER = 25000;
+    constexpr int TOTAL = NUM_PRODUCERS * ITEMS_PER_PRODUCER;
+
+    std::atomic<long long> consumed_sum{0};
+    std::atomic<int> consumed_count{0};
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < NUM_PRODUCERS; ++p) {
+        producers.emplace_back([p]() {
+            for (int i = 0; i < ITEMS_PER_PRODUCER; ++i) {
+                int value = p * ITEMS_PER_PRODUCER + i;
+                while (!buffer.push(value)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    std::thread consumer([&]() {
+        while (consumed_count.load() < TOTAL) {
+            int value;
+            if (buffer.pop(value)) {
+                consumed_sum.fetch_add(value, std::memory_order_relaxed);
+                consumed_count.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    });
+
+    for (auto& t : producers) t.join();
+    consumer.join();
+
+    // Every produced value arrived exactly once.
+    long long expected = (long long)TOTAL * (TOTAL - 1) / 2;
+    EXPECT_EQ(consumed_count.load(), TOTAL);
+    EXPECT_EQ(consumed_sum.load(), expected);
+}
+
+TEST(MpmcRingBufferTest, MultipleProducersMultipleConsumers) {
+    static MpmcRingBuffer<int, 256> buffer;
+
+    constexpr int NUM_PRODUCERS = 3;
+    constexpr int NUM_CONSUMERS = 3;
+    constexpr int ITEMS_PER_PRODUCER = 20000;
+    constexpr int TOTAL = NUM_PRODUCERS * ITEMS_PER_PRODUCER;
+
+    std::atomic<long long> consumed_sum{0};
+    std::atomic<int> consumed_count{0};
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < NUM_PRODUCERS; ++p) {
+        producers.emplace_back([p]() {
+            for (int i = 0; i < ITEMS_PER_PRODUCER; ++i) {
+                int value = p * ITEMS_PER_PRODUCER + i;
+                while (!buffer.push(value)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    std::vector<std::thread> consumers;
+    for (int c = 0; c < NUM_CONSUMERS; ++c) {
+        consumers.emplace_back([&]() {
+            while (consumed_count.load() < TOTAL) {
+                int value;
+                if (buffer.pop(value)) {
+                    consumed_sum.fetch_add(value, std::memory_order_relaxed);
+                    consumed_count.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+
+    for (auto& t : producers) t.join();
+    for (auto& t : consumers) t.join();
+
+    long long expected = (long long)TOTAL * (TOTAL - 1) / 2;
+    EXPECT_EQ(consumed_count.load(), TOTAL);
+    EXPECT_EQ(consumed_sum.load(), expected);
+}
+
 // =============================================================================
 // Memory Safety Tests (AddressSanitizer will catch issues)
 // =============================================================================
@@ -0,0 +1,420 @@
+/**
+ * Project Aegis - FastRiskEngine Unit Tests
+ *
+ * Tests the open-addressing flat shard table (FlatEntityMap)
+ * and the sharded risk evaluation path.
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../../risk_engine.hpp"
+
+// =============================================================================
+// EntityState Sliding Window Tests
+// =============================================================================
+
+TEST(EntityStateWindowTest, EventsAccumulateWithinWindow) {
+    EntityState state{};
+    uint64_t t = 10ULL * 1000000000ULL;
+    EXPECT_FLOAT_EQ(state.update_velocity(t), 1.0f);
+    EXPECT_FLOAT_EQ(state.update_velocity(t + 100000000ULL), 2.0f);
+    EXPECT_FLOAT_EQ(state.update_velocity(t + 200000000ULL), 3.0f);
+}
+
+TEST(EntityStateWindowTest, OldEventsExpireAsWindowSlides) {
+    EntityState state{};
+    uint64_t t = 10ULL * 1000000000ULL;
+    for (int i = 0; i < 5; ++i) {
+        state.update_velocity(t + (uint64_t)i * 10000000ULL);
+    }
+    // 3s later the whole 2s window has rolled past those events.
+    EXPECT_FLOAT_EQ(state.update_velocity(t + 3ULL * 1000000000ULL), 1.0f);
+}
+
+TEST(EntityStateWindowTest, PacedEventsStillAccumulate) {
+    // Events every 1.1s defeated the old hard 1s reset entirely; within
+    // the 2s rolling window each event still sees its predecessor.
+    EntityState state{};
+    uint64_t t = 10ULL * 1000000000ULL;
+    float v = 0.0f;
+    for (int i = 0; i < 5; ++i) {
+        v = state.update_velocity(t + (uint64_t)i * 1100000000ULL);
+    }
+    EXPECT_GE(v, 2.0f);
+}
+
+TEST(EntityStateWindowTest, SeededVelocityDecaysOut) {
+    EntityState state{};
+    uint64_t t = 10ULL * 1000000000ULL;
+    state.seed_velocity(12.0f, t);
+    EXPECT_FLOAT_EQ(state.velocity_accumulator.load(), 12.0f);
+    // Still visible inside the window, gone once it slides past.
+    EXPECT_FLOAT_EQ(state.update_velocity(t + 500000000ULL), 13.0f);
+    EXPECT_FLOAT_EQ(state.update_velocity(t + 5ULL * 1000000000ULL), 1.0f);
+}
+
+// =============================================================================
+// Model Weights Parsing Tests
+// =============================================================================
+
+TEST(ModelWeightsJsonTest, ParsesValidConfig) {
+    const char* json = R"({
+        "velocity_weight": 0.85,
+        "amount_weight": 0.05,
+        "structuring_weight": 0.1,
+        "velocity_threshold_1h": 5,
+        "structuring_threshold": 9000,
+        "baseline_risk": 0.05
+    })";
+    ModelWeights w{};
+    ASSERT_TRUE(FastRiskEngine::parse_weights_json(json, w));
+    EXPECT_FLOAT_EQ(w.velocity_weight, 0.85f);
+    EXPECT_FLOAT_EQ(w.structuring_weight, 0.1f);
+    EXPECT_FLOAT_EQ(w.velocity_threshold, 5.0f);
+    EXPECT_FLOAT_EQ(w.structuring_threshold, 9000.0f);
+    EXPECT_FLOAT_EQ(w.baseline, 0.05f);
+}
+
+TEST(ModelWeightsJsonTest, RejectsMissingRequiredKey) {
+    const char* json = R"({ "velocity_weight": 0.85, "structuring_weight": 0.1 })";
+    ModelWeights w{1.0f, 1.0f, 1.0f, 1.0f, 1.0f};
+    EXPECT_FALSE(FastRiskEngine::parse_weights_json(json, w));
+    EXPECT_FLOAT_EQ(w.velocity_weight, 1.0f); // untouched on failure
+}
+
+TEST(ModelWeightsJsonTest, RejectsOutOfRangeWeight) {
+    const char* json = R"({
+        "velocity_weight": 1.7,
+        "structuring_weight": 0.1,
+        "velocity_threshold_1h": 5,
+        "structuring_threshold": 9000,
+        "baseline_risk": 0.05
+    })";
+    ModelWeights w{};
+    EXPECT_FALSE(FastRiskEngine::parse_weights_json(json, w));
+}
+
+TEST(ModelWeightsJsonTest, RejectsZeroThreshold) {
+    const char* json = R"({
+        "velocity_weight": 0.8,
+        "structuring_weight": 0.1,
+        "velocity_threshold_1h": 0,
+        "structuring_threshold": 9000,
+        "baseline_risk": 0.05
+    })";
+    ModelWeights w{};
+    EXPECT_FALSE(FastRiskEngine::parse_weights_json(json, w));
+}
+
+TEST(ModelWeightsJsonTest, RejectsNonNumericValue) {
+    const char* json = R"({
+        "velocity_weight": "high",
+        "structuring_weight": 0.1,
+        "velocity_threshold_1h": 5,
+        "structuring_threshold": 9000,
+        "baseline_risk": 0.05
+    })";
+    ModelWeights w{};
+    EXPECT_FALSE(FastRiskEngine::parse_weights_json(json, w));
+}
+
+// =============================================================================
+// FlatEntityMap Tests
+// =============================================================================
+
+class FlatEntityMapTest : public ::testing::Test {
+protected:
+    FlatEntityMap map;
+};
+
+TEST_F(FlatEntityMapTest, InsertAndFind) {
+    const char* key = "Alice Smith";
+    uint64_t h = fnv1a_hash(key, strlen(key));
+
+    bool inserted = false;
+    EntityState* state = map.find_or_insert(h, key, strlen(key), inserted);
+    ASSERT_NE(state, nullptr);
+    EXPECT_TRUE(inserted);
+    EXPECT_EQ(map.size(), 1u);
+
+    state->velocity_accumulator.store(42.0f);
+
+    EntityState* found = map.find(h, key, strlen(key));
+    ASSERT_NE(found, nullptr);
+    EXPECT_EQ(found, state);
+    EXPECT_FLOAT_EQ(found->velocity_accumulator.load(), 42.0f);
+}
+
+TEST_F(FlatEntityMapTest, FindMissingReturnsNull) {
+    const char* key = "Nobody";
+    uint64_t h = fnv1a_hash(key, strlen(key));
+    EXPECT_EQ(map.find(h, key, strlen(key)), nullptr);
+}
+
+TEST_F(FlatEntityMapTest, SecondInsertReturnsSameSlot) {
+    const char* key = "Bob Jones";
+    uint64_t h = fnv1a_hash(key, strlen(key));
+
+    bool inserted = false;
+    EntityState* first = map.find_or_insert(h, key, strlen(key), inserted);
+    EXPECT_TRUE(inserted);
+
+    EntityState* second = map.find_or_insert(h, key, strlen(key), inserted);
+    EXPECT_FALSE(inserted);
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(map.size(), 1u);
+}
+
+TEST_F(FlatEntityMapTest, HashCollisionVerifiesInlineKey) {
+    // Same synthetic hash, different key bytes: the table must keep both
+    // entries distinct via inline key verification (linear probing).
+    uint64_t h = 0xDEADBEEFULL;
+
+    bool inserted = false;
+    EntityState* a = map.find_or_insert(h, "EntityA", 7, inserted);
+    EntityState* b = map.find_or_insert(h, "EntityB", 7, inserted);
+
+    ASSERT_NE(a, nullptr);
+    ASSERT_NE(b, nullptr);
+    EXPECT_NE(a, b);
+    EXPECT_EQ(map.size(), 2u);
+
+    EXPECT_EQ(map.find(h, "EntityA", 7), a);
+    EXPECT_EQ(map.find(h, "EntityB", 7), b);
+}
+
+TEST_F(FlatEntityMapTest, ProbeWindowExhaustionReturnsNull) {
+    // Saturate one probe window with colliding hashes.
+    uint64_t h = 0x1234ULL;
+    bool inserted = false;
+
+    for (size_t i = 0; i < FlatEntityMap::MAX_PROBE; ++i) {
+        std::string key = "collider_" + std::to_string(i);
+        ASSERT_NE(map.find_or_insert(h, key.c_str(), key.size(), inserted), nullptr);
+    }
+
+    EXPECT_EQ(map.find_or_insert(h, "one_too_many", 12, inserted), nullptr);
+    EXPECT_FALSE(inserted);
+}
+
+TEST_F(FlatEntityMapTest, LongKeysAreTruncatedConsistently) {
+    std::string long_key(100, 'x');
+    uint64_t h = fnv1a_hash(long_key.c_str(), long_key.size());
+
+    bool inserted = false;
+    EntityState* a = map.find_or_insert(h, long_key.c_str(), long_key.size(), inserted);
+    ASSERT_NE(a, nullptr);
+
+    // Lookup with the same over-long key must hit the same slot.
+    EXPECT_EQ(map.find(h, long_key.c_str(), long_key.size()), a);
+}
+
+// =============================================================================
+// Eviction / Tiered Storage Tests
+// =============================================================================
+
+TEST_F(FlatEntityMapTest, EvictingInsertDemotesColdEntryWhenWindowFull) {
+    uint64_t h = 0x1234ULL;
+    bool inserted = false;
+
+    for (size_t i = 0; i < FlatEntityMap::MAX_PROBE; ++i) {
+        std::string key = "collider_" + std::to_string(i);
+        ASSERT_NE(map.find_or_insert(h, key.c_str(), key.size(), inserted), nullptr);
+    }
+
+    // Every slot in the window was just claimed, so every ref bit is set:
+    // the first evicting insert may only age the window and must fail
+    // rather than demote a referenced entry.
+    FlatEntityMap::Evicted evicted;
+    EntityState* state = map.find_or_insert_evicting(h, "newcomer", 8, inserted, evicted);
+    EXPECT_EQ(state, nullptr);
+    EXPECT_FALSE(inserted);
+    EXPECT_FALSE(evicted.valid);
+
+    // The retry finds the aged window and demotes exactly one cold victim.
+    state = map.find_or_insert_evicting(h, "newcomer", 8, inserted, evicted);
+    ASSERT_NE(state, nullptr);
+    EXPECT_TRUE(inserted);
+    EXPECT_TRUE(evicted.valid);
+
+    // The victim's key is gone from the table; the newcomer is present.
+    EXPECT_EQ(map.find(h, evicted.key, strlen(evicted.key)), nullptr);
+    EXPECT_EQ(map.find(h, "newcomer", 8), state);
+}
+
+TEST_F(FlatEntityMapTest, EvictingInsertSparesRecentlyReferencedEntries) {
+    uint64_t h = 0x4242ULL;
+    bool inserted = false;
+
+    for (size_t i = 0; i < FlatEntityMap::MAX_PROBE; ++i) {
+        std::string key = "hot_" + std::to_string(i);
+        ASSERT_NE(map.find_or_insert(h, key.c_str(), key.size(), inserted), nullptr);
+    }
+
+    // Age the window once, then re-reference one entry via the read path.
+    FlatEntityMap::Evicted evicted;
+    ASSERT_EQ(map.find_or_insert_evicting(h, "cuckoo", 6, inserted, evicted), nullptr);
+    ASSERT_NE(map.find(h, "hot_0", 5), nullptr);
+
+    // The re-referenced entry survives; some other (cold) entry is demoted.
+    EntityState* state = map.find_or_insert_evicting(h, "cuckoo", 6, inserted, evicted);
+    ASSERT_NE(state, nullptr);
+    ASSERT_TRUE(evicted.valid);
+    EXPECT_STRNE(evicted.key, "hot_0");
+    EXPECT_NE(map.find(h, "hot_0", 5), nullptr);
+}
+
+TEST_F(FlatEntityMapTest, EvictingInsertNeverRecyclesForeignPartitionSlots) {
+    // Colliders share the newcomer's home slot (same low bits) but belong
+    // to a different worker partition mod 3 (CAPACITY % 3 != 0 makes that
+    // possible with a +CAPACITY offset).
+    uint64_t h = 0x2400ULL;
+    uint64_t h_foreign = h + FlatEntityMap::CAPACITY;
+    ASSERT_NE(h % 3, h_foreign % 3);
+
+    bool inserted = false;
+    for (size_t i = 0; i < FlatEntityMap::MAX_PROBE; ++i) {
+        std::string key = "foreign_" + std::to_string(i);
+        ASSERT_NE(map.find_or_insert(h_foreign, key.c_str(), key.size(), inserted), nullptr);
+    }
+
+    // With 3 partitions every occupant is owned by another worker, so the
+    // insert must keep failing no matter how often the window is swept.
+    FlatEntityMap::Evicted evicted;
+    for (int attempt = 0; attempt < 3; ++attempt) {
+        EXPECT_EQ(map.find_or_insert_evicting(h, "outsider", 8, inserted, evicted, 3), nullptr);
+        EXPECT_FALSE(evicted.valid);
+    }
+
+    // A single-writer caller (partitions = 1) may demote here. The
+    // restricted sweeps above never touched foreign ref bits, so this
+    // caller still ages the window once before evicting.
+    ASSERT_EQ(map.find_or_insert_evicting(h, "outsider", 8, inserted, evicted, 1), nullptr);
+    EntityState* state = map.find_or_insert_evicting(h, "outsider", 8, inserted, evicted, 1);
+    ASSERT_NE(state, nullptr);
+    EXPECT_TRUE(evicted.valid);
+}
+
+TEST_F(FlatEntityMapTest, EvictedSnapshotCarriesState) {
+    uint64_t h = 0x5678ULL;
+    bool inserted = false;
+
+    for (size_t i = 0; i < FlatEntityMap::MAX_PROBE; ++i) {
+        std::string key = "entity_" + std::to_string(i);
+        EntityState* s = map.find_or_insert(h, key.c_str(), key.size(), inserted);
+        ASSERT_NE(s, nullptr);
+        s->velocity_accumulator.store(static_cast<float>(i));
+    }
+
+    FlatEntityMap::Evicted evicted;
+    ASSERT_EQ(map.find_or_insert_evicting(h, "intruder", 8, inserted, evicted), nullptr);
+    map.find_or_insert_evicting(h, "intruder", 8, inserted, evicted);
+    ASSERT_TRUE(evicted.valid);
+
+    // Snapshot must match the state the victim held.
+    std::string victim(evicted.key);
+    ASSERT_EQ(victim.rfind("entity_", 0), 0u);
+    float expected = std::stof(victim.substr(7));
+    EXPECT_FLOAT_EQ(evicted.velocity, expected);
+}
+
+TEST(DistrubutedCacheTest, SpillAndFetchRoundtrip) {
+    DistrubutedCache::spill("Cold Corp", {123456789ULL, 7.0f, 0.5f});
+
+    DistrubutedCache::TieredEntry out;
+    ASSERT_TRUE(DistrubutedCache::fetch("Cold Corp", out));
+    EXPECT_EQ(out.last_seen, 123456789ULL);
+    EXPECT_FLOAT_EQ(out.velocity, 7.0f);
+    EXPECT_FLOAT_EQ(out.structuring, 0.5f);
+
+    EXPECT_FALSE(DistrubutedCache::fetch("Never Seen", out));
+}
+
+// =============================================================================
+// FastRiskEngine Evaluation Tests
+// =============================================================================
+
+class RiskEngineTest : public ::testing::Test {
+protected:
+    std::unique_ptr<FastRiskEngine> engine;
+
+    void SetUp() override {
+        engine = std::make_unique<FastRiskEngine>();
+    }
+
+    FastRiskEngine::RiskResult eval(const char* name, int64_t amount_micros) {
+        return engine->evaluate(name, strlen(name), amount_micros);
+    }
+};
+
+TEST_F(RiskEngineTest, BaselineScoreForSingleSmallPayment) {
+    auto r = eval("Quiet Entity", 100 * 1000000LL); // 100.00
+    EXPECT_FALSE(r.is_blocked);
+    EXPECT_LT(r.score, 0.5f);
+}
+
+TEST_F(RiskEngineTest, VelocityRaisesScore) {
+    float first = eval("Rapid Fire Corp", 100 * 1000000LL).score;
+    float later = 0.0f;
+    for (int i = 0; i < 20; ++i) {
+        later = eval("Rapid Fire Corp", 100 * 1000000LL).score;
+    }
+    EXPECT_GT(later, first);
+}
+
+TEST_F(RiskEngineTest, StructuringBandScoresHigher) {
+    // Just below the 10k reporting limit (structuring band).
+    auto structured = eval("Structurer A", 9500 * 1000000LL);
+    auto normal = eval("Structurer B", 500 * 1000000LL);
+    EXPECT_GT(structured.score, normal.score);
+}
+
+TEST_F(RiskEngineTest, DistinctEntitiesTrackedIndependently) {
+    for (int i = 0; i < 10; ++i) {
+        eval("Busy Entity", 100 * 1000000LL);
+    }
+    auto fresh = eval("Fresh Entity", 100 * 1000000LL);
+    EXPECT_LT(fresh.score, 0.5f);
+}
+
+// Mirrors the production partitioning contract behind the lock-free hit
+// path: each thread owns a disjoint entity set (ingress routes an entity
+// to exactly one worker), so concurrent evaluation must be race-free even
+// when the sets collide on shards and force inserts alongside lock-free
+// reads.
+TEST_F(RiskEngineTest, ConcurrentPartitionedEvaluation) {
+    constexpr int kThreads = 4;
+    constexpr int kEntities = 300;  // per thread; enough to share shards
+    constexpr int kRounds = 50;
+
+    std::vector<std::thread> threads;
+    std::atomic<int> bad_scores{0};
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([this, t, &bad_scores] {
+            char name[64];
+            for (int round = 0; round < kRounds; ++round) {
+                for (int e = 0; e < kEntities; ++e) {
+                    snprintf(name, sizeof(name), "Owner%d-Entity%d", t, e);
+                    auto r = engine->evaluate(name, strlen(name), 500 * 1000000LL);
+                    if (r.score < 0.0f || r.score > 1.0f) bad_scores++;
+                }
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+    EXPECT_EQ(bad_scores.load(), 0);
+
+    // Hot entities are found via the lock-free path afterwards too.
+    auto r = eval("Owner0-Entity0", 500 * 1000000LL);
+    EXPECT_GE(r.score, 0.0f);
+    EXPECT_LE(r.score, 1.0f);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -12,9 +12,18 @@
 #include <string>
 #include <sstream>
 #include <fstream>
+#include <streambuf>
+#include <memory>
 #include <vector>
 #include <stdexcept>
 
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 // Essential libsnark headers
 #include <libsnark/gadgetlib1/gadget.hpp>
 #include <libsnark/gadgetlib1/protoboard.hpp>
@@ -32,6 +41,7 @@ using PP = libsnark::default_r1cs_ppzksnark_pp;
 using Proof = libsnark::r1cs_ppzksnark_proof<PP>;
 using PK = libsnark::r1cs_ppzksnark_proving_key<PP>;
 using VK = libsnark::r1cs_ppzksnark_verification_key<PP>;
+using PVK = libsnark::r1cs_ppzksnark_processed_verification_key<PP>;
 
 // Circuit: Age Integrity Check
 // Proves: (CurrentYear - BirthYear) >= Threshold
@@ -116,6 +126,48 @@ public:
     }
 };
 
+// Reusable prover state: the circuit, protoboard and constraint system are
+// identical for every proof — only the witness changes. Building them per
+// proof (allocation, constraint generation) is pure wasted CPU in a
+// high-volume proving path, so construct this once and call prove() per
+// request. generate_witness overwrites every variable assignment, so the
+// protoboard is safely reused; the context itself is NOT thread-safe
+// (witness values live in the shared protoboard) — give each prover
+// thread its own, all sharing the read-only PK.
+class ProverContext {
+    const PK& pk;
+    protoboard<FieldT> pb;
+    pb_variable<FieldT> curr, thresh, birth;
+    std::unique_ptr<AgeCheckCircuit> circuit;
+
+public:
+    explicit ProverContext(const PK& proving_key) : pk(proving_key) {
+        // Exact same allocation order as the trusted setup.
+        curr.allocate(pb, "current_year");
+        thresh.allocate(pb, "threshold");
+        birth.allocate(pb, "birth_year");
+
+        pb.set_input_sizes(2);
+
+        circuit.reset(new AgeCheckCircuit(pb, curr, birth, thresh));
+        circuit->generate_r1cs_constraints(); // once, not per proof
+    }
+
+    std::string prove(long current_year, long threshold, long birth_year) {
+        circuit->generate_witness(current_year, birth_year, threshold);
+
+        if (!pb.is_satisfied()) {
+             throw std::runtime_error("Constraint Failure: Inputs invalid (Underage or bad math).");
+        }
+
+        Proof proof = libsnark::r1cs_ppzksnark_prover<PP>(pk, pb.primary_input(), pb.auxiliary_input());
+
+        std::stringstream ss;
+        ss << proof;
+        return ss.str();
+    }
+};
+
 class ZkpManager {
 public:
 
@@ -156,47 +208,33 @@ public:
         std::cout << "[ZKP] Trusted Setup Complete. Keys saved to disk." << std::endl;
     }
 
+    // Key loading. BN128 proving keys run to hundreds of MB; streaming them
+    // through an ifstream costs a read-syscall-and-copy per buffer refill.
+    // We mmap the file and deserialize straight out of the mapping instead:
+    // the kernel faults pages in sequentially (MADV_SEQUENTIAL readahead)
+    // and the parser never touches a userspace copy. Curve points still
+    // have to be parsed — libsnark's group elements own heap storage, so a
+    // true pointer-fixup in-place format would mean reimplementing its
+    // serialization — but long-running processes should load once and keep
+    // the key resident (see zkp_prover daemon mode) rather than lean on
+    // load speed.
     static PK load_pk(const std::string& path) {
         PK pk;
-        std::ifstream file(path, std::ios::binary);
-        if (!file) throw std::runtime_error("Missing Proving Key: " + path);
-        file >> pk;
+        load_key(path, pk, "Proving Key");
         return pk;
     }
 
     static VK load_vk(const std::string& path) {
         VK vk;
-        std::ifstream file(path, std::ios::binary);
-        if (!file) throw std::runtime_error("Missing Verification Key: " + path);
-        file >> vk;
+        load_key(path, vk, "Verification Key");
         return vk;
     }
 
     // --- PROVER ---
+    // One-shot convenience; repeat callers should hold a ProverContext.
     static std::string generate_proof(const PK& pk, long current_year, long threshold, long birth_year) {
-        protoboard<FieldT> pb;
-        pb_variable<FieldT> curr, thresh, birth;
-
-        // Exact same allocation order
-        curr.allocate(pb, "current_year");
-        thresh.allocate(pb, "threshold");
-        birth.allocate(pb, "birth_year");
-
-        pb.set_input_sizes(2);
-
-        AgeCheckCircuit circuit(pb, curr, birth, thresh);
-        circuit.generate_r1cs_constraints();
-        circuit.generate_witness(current_year, birth_year, threshold);
-
-        if (!pb.is_satisfied()) {
-             throw std::runtime_error("Constraint Failure: Inputs invalid (Underage or bad math).");
-        }
-
-        Proof proof = libsnark::r1cs_ppzksnark_prover<PP>(pk, pb.primary_input(), pb.auxiliary_input());
-
-        std::stringstream ss;
-        ss << proof;
-        return ss.str();
+        ProverContext ctx(pk);
+        return ctx.prove(current_year, threshold, birth_year);
     }
 
     // --- VERIFIER (REAL) ---
@@ -213,6 +251,64 @@ public:
 
         return libsnark::r1cs_ppzksnark_verifier_strong_IC<PP>(vk, primary_input, proof);
     }
+
+    // Batch verification path: the r1cs_ppzksnark verifier splits into an
+    // offline VK-processing step (pairing precomputation over the VK's
+    // group elements) and a cheap online check per proof. Process the VK
+    // once per batch, then verify each entry against the processed key.
+    static PVK process_vk(const VK& vk) {
+        return libsnark::r1cs_ppzksnark_verifier_process_vk<PP>(vk);
+    }
+
+    static bool verify_proof_processed(const PVK& pvk, const std::string& proof_str,
+                                       long current_year, long threshold) {
+        Proof proof;
+        std::stringstream ss(proof_str);
+        ss >> proof;
+
+        std::vector<FieldT> primary_input;
+        primary_input.push_back(FieldT(current_year));
+        primary_input.push_back(FieldT(threshold));
+
+        return libsnark::r1cs_ppzksnark_online_verifier_strong_IC<PP>(pvk, primary_input, proof);
+    }
+
+private:
+    // Read-only streambuf over an existing byte range (no copy).
+    class MappedBuf : public std::streambuf {
+    public:
+        MappedBuf(char* base, size_t size) { setg(base, base, base + size); }
+    };
+
+    template <typename KeyT>
+    static void load_key(const std::string& path, KeyT& key, const char* what) {
+#ifndef _WIN32
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error(std::string("Missing ") + what + ": " + path);
+
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size > 0) {
+            void* base = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            ::close(fd);
+            if (base != MAP_FAILED) {
+                madvise(base, (size_t)st.st_size, MADV_SEQUENTIAL);
+                MappedBuf buf(static_cast<char*>(base), (size_t)st.st_size);
+                std::istream is(&buf);
+                is >> key;
+                bool ok = !is.bad();
+                munmap(base, (size_t)st.st_size);
+                if (!ok) throw std::runtime_error(std::string("Corrupt ") + what + ": " + path);
+                return;
+            }
+        } else {
+            ::close(fd);
+        }
+#endif
+        // Fallback (Windows, empty file, mmap failure): buffered stream.
+        std::ifstream file(path, std::ios::binary);
+        if (!file) throw std::runtime_error(std::string("Missing ") + what + ": " + path);
+        file >> key;
+    }
 };
 
 #endif
@@ -1,9 +1,17 @@
 /*
  * Project Aegis - ZKP Prover Service
  * Usage:
- *   1. Setup: ./zkp_prover setup <pk_path> <vk_path>
- *   2. Prove: ./zkp_prover <pk_path> <current_year> <threshold> <birth_year>
+ *   1. Setup:  ./zkp_prover setup <pk_path> <vk_path>
+ *   2. Prove:  ./zkp_prover <pk_path> <current_year> <threshold> <birth_year>
+ *   3. Daemon: ./zkp_prover daemon <pk_path> <socket_path> [num_workers]
  * Output: Proof Hex string
+ *
+ * One-shot mode pays the full proving-key deserialization (~10s for BN128
+ * keys) per proof. Daemon mode loads the key once and serves proof
+ * requests concurrently (num_workers provers, default hardware
+ * concurrency, bounded request queue) over a Unix domain socket:
+ *   request:  "<current_year> <threshold> <birth_year>\n"
+ *   response: "OK <proof_len>\n<proof bytes>"  or  "ERR <reason>\n"
  */
 
 #include "zkp_circuits.hpp"
@@ -13,8 +21,245 @@
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <csignal>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#ifndef _WIN32
+static volatile sig_atomic_t g_daemon_running = 1;
+
+static void daemon_signal_handler(int) {
+    g_daemon_running = 0;
+}
+
+// Reads one newline-terminated request line (bounded).
+static bool read_request_line(int fd, std::string& line) {
+    line.clear();
+    char c;
+    while (line.size() < 256) {
+        ssize_t n = ::read(fd, &c, 1);
+        if (n <= 0) return false;
+        if (c == '\n') return true;
+        line.push_back(c);
+    }
+    return false;
+}
+
+static void write_all(int fd, const char* data, size_t len) {
+    size_t off = 0;
+    while (off < len) {
+        ssize_t n = ::write(fd, data + off, len - off);
+        if (n <= 0) return;
+        off += (size_t)n;
+    }
+}
+
+// Bounded queue of accepted client fds feeding the prover worker pool.
+// Proofs take seconds each; a mutex/condvar queue is plenty here, and the
+// bound turns overload into fast-fail admission control at accept time
+// instead of an ever-growing backlog of stalled clients.
+class ProofRequestQueue {
+    std::deque<int> fds;
+    std::mutex mtx;
+    std::condition_variable cv;
+    size_t capacity;
+    bool closed = false;
+
+public:
+    explicit ProofRequestQueue(size_t cap) : capacity(cap) {}
+
+    // Non-blocking; false when the queue is full (caller rejects the client).
+    bool try_push(int fd) {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            if (closed || fds.size() >= capacity) return false;
+            fds.push_back(fd);
+        }
+        cv.notify_one();
+        return true;
+    }
+
+    // Blocks until a request arrives or the queue is closed.
+    bool pop(int& fd) {
+        std::unique_lock<std::mutex> lock(mtx);
+        cv.wait(lock, [this] { return closed || !fds.empty(); });
+        if (fds.empty()) return false;
+        fd = fds.front();
+        fds.pop_front();
+        return true;
+    }
+
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            closed = true;
+        }
+        cv.notify_all();
+    }
+};
+
+// Per-proof latency accounting, logged periodically by the workers.
+struct ProofStats {
+    std::atomic<uint64_t> proofs{0};
+    std::atomic<uint64_t> failures{0};
+    std::atomic<uint64_t> total_ms{0};
+    std::atomic<uint64_t> max_ms{0};
+
+    void record(uint64_t ms, bool ok) {
+        if (!ok) { failures.fetch_add(1, std::memory_order_relaxed); return; }
+        uint64_t n = proofs.fetch_add(1, std::memory_order_relaxed) + 1;
+        total_ms.fetch_add(ms, std::memory_order_relaxed);
+        uint64_t prev = max_ms.load(std::memory_order_relaxed);
+        while (ms > prev && !max_ms.compare_exchange_weak(prev, ms)) {}
+        if (n % 32 == 0) {
+            printf("[ZKPD] %llu proofs | avg %llu ms | max %llu ms | %llu failed\n",
+                   (unsigned long long)n,
+                   (unsigned long long)(total_ms.load(std::memory_order_relaxed) / n),
+                   (unsigned long long)max_ms.load(std::memory_order_relaxed),
+                   (unsigned long long)failures.load(std::memory_order_relaxed));
+        }
+    }
+};
+
+static void serve_client(int fd, ProverContext& ctx, ProofStats& stats) {
+    std::string line;
+    if (!read_request_line(fd, line)) {
+        ::close(fd);
+        return;
+    }
+
+    long current_year, threshold, birth_year;
+    if (sscanf(line.c_str(), "%ld %ld %ld", &current_year, &threshold, &birth_year) != 3) {
+        const char* err = "ERR malformed request\n";
+        write_all(fd, err, strlen(err));
+        ::close(fd);
+        return;
+    }
+
+    auto t0 = std::chrono::steady_clock::now();
+    try {
+        std::string proof = ctx.prove(current_year, threshold, birth_year);
+        auto t1 = std::chrono::steady_clock::now();
+        stats.record((uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count(), true);
+
+        std::string header = "OK " + std::to_string(proof.size()) + "\n";
+        write_all(fd, header.data(), header.size());
+        write_all(fd, proof.data(), proof.size());
+    } catch (const std::exception& e) {
+        stats.record(0, false);
+        std::string err = std::string("ERR ") + e.what() + "\n";
+        write_all(fd, err.data(), err.size());
+    }
+    ::close(fd);
+}
+
+static int run_daemon(const std::string& pk_path, const std::string& socket_path,
+                      size_t num_workers) {
+    if (num_workers < 1) num_workers = 1;
+
+    // Load once; every served proof reuses the resident key. The key is
+    // read-only after this point, so all prover workers share it directly.
+    std::cout << "[ZKPD] Loading proving key (one-time)..." << std::endl;
+    PK pk = ZkpManager::load_pk(pk_path);
+    std::cout << "[ZKPD] Proving key resident." << std::endl;
+
+    int srv = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (srv < 0) {
+        std::cerr << "FATAL: socket() failed" << std::endl;
+        return 1;
+    }
+
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, socket_path.c_str(), sizeof(addr.sun_path) - 1);
+    ::unlink(socket_path.c_str());
+
+    if (bind(srv, (struct sockaddr*)&addr, sizeof(addr)) < 0 || listen(srv, 16) < 0) {
+        std::cerr << "FATAL: cannot bind " << socket_path << std::endl;
+        ::close(srv);
+        return 1;
+    }
+
+    // sigaction without SA_RESTART: glibc signal() implies BSD semantics,
+    // which would auto-restart the blocking accept() below and leave the
+    // daemon running until the next client connects. The accept loop
+    // depends on EINTR to observe the stop flag.
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = daemon_signal_handler;
+    sigemptyset(&sa.sa_mask);
+    sa.sa_flags = 0;
+    sigaction(SIGINT, &sa, nullptr);
+    sigaction(SIGTERM, &sa, nullptr);
+
+    // Worker pool: protoboard/witness setup is per-request and independent,
+    // and r1cs_ppzksnark_prover only reads the shared PK, so N proofs run
+    // truly concurrently. Queue depth 2x pool size keeps workers fed
+    // without letting a burst build unbounded latency.
+    ProofRequestQueue queue(num_workers * 2);
+    ProofStats stats;
+
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < num_workers; ++i) {
+        workers.emplace_back([&]() {
+            // Circuit + constraint system built once per worker; each proof
+            // only regenerates the witness (see ProverContext).
+            ProverContext ctx(pk);
+            int fd;
+            while (queue.pop(fd)) {
+                serve_client(fd, ctx, stats);
+            }
+        });
+    }
+
+    std::cout << "[ZKPD] Serving proof requests on " << socket_path
+              << " | Workers: " << num_workers << std::endl;
+
+    while (g_daemon_running) {
+        int fd = accept(srv, nullptr, nullptr);
+        if (fd < 0) {
+            if (g_daemon_running) continue; // EINTR etc.
+            break;
+        }
+        if (!queue.try_push(fd)) {
+            // Saturated: fail fast so the client can back off or retry
+            // against another instance, instead of queueing behind seconds
+            // of proving work.
+            const char* err = "ERR busy\n";
+            write_all(fd, err, strlen(err));
+            ::close(fd);
+        }
+    }
+
+    queue.close();
+    for (std::thread& t : workers) t.join();
+
+    ::close(srv);
+    ::unlink(socket_path.c_str());
+    std::cout << "[ZKPD] Shutdown." << std::endl;
+    return 0;
+}
+#endif // !_WIN32
 
 int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0]
+                  << " setup|daemon|<pk_path> ... (see header)" << std::endl;
+        return 1;
+    }
+
     // 1. Initialize Crypto Subsystem
     try {
         ZkpManager::init();
@@ -35,6 +280,24 @@ int main(int argc, char* argv[]) {
         return 0;
     }
 
+#ifndef _WIN32
+    if (mode == "daemon") {
+        if (argc != 4 && argc != 5) {
+            std::cerr << "Usage: " << argv[0]
+                      << " daemon <pk_path> <socket_path> [num_workers]" << std::endl;
+            return 1;
+        }
+        try {
+            size_t num_workers = (argc == 5) ? (size_t)std::stoul(argv[4])
+                                             : std::thread::hardware_concurrency();
+            return run_daemon(argv[2], argv[3], num_workers);
+        } catch (const std::exception& e) {
+            std::cerr << "FATAL: Daemon startup failed: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+#endif
+
     if (argc != 5) {
         std::cerr << "Usage: " << argv[0] << " <pk_path> <current_year> <threshold> <birth_year>" << std::endl;
         return 1;
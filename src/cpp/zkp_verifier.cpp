@@ -10,13 +10,119 @@
 #include <libsnark/gadgetlib1/protoboard.hpp>
 #include <libsnark/gadgetlib1/gadget.hpp>
 #include <libff/common/utils.hpp>
+#include <atomic>
+#include <chrono>
+#include <fstream>
 #include <iostream>
+#include <sstream>
 #include <string>
+#include <thread>
+#include <vector>
+
+// One manifest entry: a proof file plus its public inputs.
+struct BatchEntry {
+    std::string proof_path;
+    long current_year;
+    long threshold;
+    bool valid = false;
+    bool error = false;
+};
+
+// Batch mode: verify a manifest of (proof_file, current_year, threshold)
+// lines that all share one verification key. The VK's pairing
+// precomputation (r1cs_ppzksnark_verifier_process_vk) runs once; the cheap
+// online check then fans out across a thread pool. Settlement batches of
+// hundreds of proofs amortize VK processing to noise this way.
+static int run_batch(const std::string& vk_path, const std::string& manifest_path,
+                     size_t num_workers) {
+    if (num_workers < 1) num_workers = 1;
+
+    std::ifstream manifest(manifest_path);
+    if (!manifest) {
+        std::cerr << "ERROR: Cannot open manifest: " << manifest_path << std::endl;
+        return 1;
+    }
+
+    std::vector<BatchEntry> entries;
+    std::string line;
+    while (std::getline(manifest, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        BatchEntry e;
+        std::istringstream ls(line);
+        if (!(ls >> e.proof_path >> e.current_year >> e.threshold)) {
+            std::cerr << "ERROR: Malformed manifest line: " << line << std::endl;
+            return 1;
+        }
+        entries.push_back(e);
+    }
+    if (entries.empty()) {
+        std::cerr << "ERROR: Empty manifest." << std::endl;
+        return 1;
+    }
+
+    auto t0 = std::chrono::steady_clock::now();
+
+    VK vk = ZkpManager::load_vk(vk_path);
+    PVK pvk = ZkpManager::process_vk(vk); // once per batch, not per proof
+
+    std::atomic<size_t> next{0};
+    std::vector<std::thread> workers;
+    for (size_t w = 0; w < num_workers; ++w) {
+        workers.emplace_back([&]() {
+            size_t i;
+            while ((i = next.fetch_add(1, std::memory_order_relaxed)) < entries.size()) {
+                BatchEntry& e = entries[i];
+                std::ifstream pf(e.proof_path, std::ios::binary);
+                if (!pf) {
+                    e.error = true;
+                    continue;
+                }
+                std::stringstream ss;
+                ss << pf.rdbuf();
+                try {
+                    e.valid = ZkpManager::verify_proof_processed(
+                        pvk, ss.str(), e.current_year, e.threshold);
+                } catch (const std::exception&) {
+                    e.error = true;
+                }
+            }
+        });
+    }
+    for (std::thread& t : workers) t.join();
+
+    auto t1 = std::chrono::steady_clock::now();
+    long ms = (long)std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count();
+
+    size_t passed = 0, failed = 0, errored = 0;
+    for (size_t i = 0; i < entries.size(); ++i) {
+        const BatchEntry& e = entries[i];
+        const char* status = e.error ? "ERROR" : (e.valid ? "PASS" : "FAIL");
+        std::cout << status << " " << e.proof_path << std::endl;
+        if (e.error) errored++;
+        else if (e.valid) passed++;
+        else failed++;
+    }
+
+    std::cout << "BATCH_SUMMARY proofs=" << entries.size()
+              << " passed=" << passed << " failed=" << failed
+              << " errored=" << errored << " workers=" << num_workers
+              << " wall_ms=" << ms << std::endl;
+
+    return (failed == 0 && errored == 0) ? 0 : 2;
+}
 
 int main(int argc, char* argv[]) {
-    // Usage: zkp_verifier <proof_hex_string> <current_year> <threshold> <vk_path>
-    if (argc != 5) {
-        std::cerr << "Usage: " << argv[0] << " <proof_string> <current_year> <threshold> <vk_path>" << std::endl;
+    // Usage (single): zkp_verifier <proof_hex_string> <current_year> <threshold> <vk_path>
+    // Usage (batch):  zkp_verifier batch <vk_path> <manifest_path> [num_workers]
+    //   manifest lines: <proof_file> <current_year> <threshold>
+    bool batch_mode = (argc >= 2 && std::string(argv[1]) == "batch");
+    if (!batch_mode && argc != 5) {
+        std::cerr << "Usage: " << argv[0] << " <proof_string> <current_year> <threshold> <vk_path>\n"
+                  << "       " << argv[0] << " batch <vk_path> <manifest_path> [num_workers]" << std::endl;
+        return 1;
+    }
+    if (batch_mode && argc != 4 && argc != 5) {
+        std::cerr << "Usage: " << argv[0] << " batch <vk_path> <manifest_path> [num_workers]" << std::endl;
         return 1;
     }
 
@@ -27,6 +133,17 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
+    if (batch_mode) {
+        try {
+            size_t num_workers = (argc == 5) ? (size_t)std::stoul(argv[4])
+                                             : std::thread::hardware_concurrency();
+            return run_batch(argv[2], argv[3], num_workers);
+        } catch (const std::exception& e) {
+            std::cerr << "ERROR: Batch verification failed: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+
     std::string proof_str = argv[1];
     long current_year = std::stol(argv[2]);
     long threshold = std::stol(argv[3]);